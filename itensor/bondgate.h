@@ -5,7 +5,8 @@
 #ifndef __ITENSOR_BONDGATE_H
 #define __ITENSOR_BONDGATE_H
 
-#include "iqtensor.h"
+#include "svdworker.h"
+#include "model.h"
 
 template <class Tensor>
 class BondGate
@@ -35,12 +36,77 @@ class BondGate
     Type
     type() const { return type_; }
 
+    //Discard all gates saved by the bondH/tau constructor
+    static void
+    clearCache();
+
     private:
 
     Type type_;
     int i_,j_; // The left, right indices of bond
     Tensor gate_;
 
+    void
+    makeExpH(const Model& model, Tensor bondH, Real tau);
+
+    //
+    // Gates computed from a given bondH and tau
+    // are saved so that rebuilding the same gate
+    // (e.g. for each step of a Trotter sequence 
+    // or each sweep of a tau schedule) 
+    // only costs a tensor comparison.
+    // The cache is shared by all threads; it is only
+    // accessed inside the critical section bondgate_cache.
+    //
+    struct CacheEntry
+        {
+        Type type;
+        Real tau;
+        Tensor bondH;
+        Tensor gate;
+        };
+
+    static const size_t max_cache_size = 200;
+
+    static std::list<CacheEntry>&
+    cache()
+        {
+        static std::list<CacheEntry> cache_;
+        return cache_;
+        }
+
+    //Function objects used to exponentiate eigenvalues
+    //(shifted by -1, see makeExpH)
+    class ExpScale
+        {
+        public:
+        ExpScale(Real fac) : fac_(fac) { }
+        Real
+        operator()(Real x) const { return exp(fac_*x)-1; }
+        private:
+        Real fac_;
+        };
+
+    class CosScale
+        {
+        public:
+        CosScale(Real fac) : fac_(fac) { }
+        Real
+        operator()(Real x) const { return cos(fac_*x)-1; }
+        private:
+        Real fac_;
+        };
+
+    class SinScale
+        {
+        public:
+        SinScale(Real fac) : fac_(fac) { }
+        Real
+        operator()(Real x) const { return sin(fac_*x); }
+        private:
+        Real fac_;
+        };
+
     };
 
 template <class Tensor>
@@ -69,26 +135,103 @@ BondGate(const Model& model, int i, int j,
         {
         Error("When providing bondH, type must be tReal or tImag");
         }
-    bondH *= -tau;
-    Tensor unit = model.id(i)*model.id(j);
-    if(type_ == tReal)
+    bool found = false;
+#ifdef _OPENMP
+#pragma omp critical(bondgate_cache)
+#endif
+        {
+        Foreach(const CacheEntry& e, cache())
+            {
+            if(e.type != type_ || e.tau != tau) continue;
+            if(e.bondH.uniqueReal() != bondH.uniqueReal()) continue;
+            if((e.bondH-bondH).norm() != 0) continue;
+            gate_ = e.gate;
+            found = true;
+            break;
+            }
+        }
+    if(found) return;
+
+    //Computed outside the critical section so
+    //that errors can propagate
+    makeExpH(model,bondH,tau);
+
+    CacheEntry e;
+    e.type = type_;
+    e.tau = tau;
+    e.bondH = bondH;
+    e.gate = gate_;
+#ifdef _OPENMP
+#pragma omp critical(bondgate_cache)
+#endif
+        {
+        cache().push_front(e);
+        if(cache().size() > max_cache_size) cache().pop_back();
+        }
+    }
+
+template <class Tensor>
+void BondGate<Tensor>::
+clearCache()
+    {
+#ifdef _OPENMP
+#pragma omp critical(bondgate_cache)
+#endif
+    cache().clear();
+    }
+
+//
+// Computes exp(-tau*bondH) (or exp(-i*tau*bondH) for tReal)
+// from the eigendecomposition bondH = conj(U)*D*primed(U),
+// exponentiating the eigenvalues exactly. 
+// (For a complex Hermitian bondH, U is complex.)
+//
+template <class Tensor>
+void BondGate<Tensor>::
+makeExpH(const Model& model, Tensor bondH, Real tau)
+    {
+    typedef typename Tensor::SparseT
+    SparseT;
+
+    Tensor U;
+    SparseT D;
+    try {
+        diagHermitian(bondH,U,D);
+        }
+    catch(const ResultIsZero& e)
+        {
+        //exp(0) is the identity
+        gate_ = model.id(i_)*model.id(j_);
+        if(type_ == tReal || isComplex(bondH)) gate_ *= Tensor::Complex_1();
+        return;
+        }
+
+    //bondH may have no blocks in some QN sectors, in which
+    //case U only spans part of the space. Writing
+    //exp(X) = 1 + U*(exp(D)-1)*U^dag handles the remaining
+    //sectors where the gate is the identity.
+    const bool cplx = isComplex(U);
+    const Tensor Uc = conj(U),
+                 Up = primed(U);
+    Tensor unit = model.id(i_)*model.id(j_);
+    if(cplx) unit *= Tensor::Complex_1();
+
+    if(type_ == tImag)
         {
-        bondH *= Tensor::Complex_i();
-        unit  *= Tensor::Complex_1();
+        D.mapElems(ExpScale(-tau));
+        gate_ = unit + Uc*D*Up;
         }
-    Tensor term = bondH;
-    bondH.mapprime(1,2);
-    bondH.mapprime(0,1);
-
-    // exp(x) = 1 + x +  x^2/2! + x^3/3! ..
-    // = 1 + x * (1 + x/2 *(1 + x/3 * (...
-    // ~ ((x/3 + 1) * x/2 + 1) * x + 1
-    for(int ord = 100; ord >= 1; --ord)
+    else
         {
-        term /= ord;
-        gate_ = unit + term;
-        term = gate_ * bondH;
-        term.mapprime(2,1);
+        //exp(-i*tau*x) = cos(tau*x) - i*sin(tau*x)
+        SparseT C(D),
+                S(D);
+        C.mapElems(CosScale(tau));
+        S.mapElems(SinScale(tau));
+        S *= -1;
+        gate_ = unit + Uc*C*Up;
+        if(!cplx) gate_ *= Tensor::Complex_1();
+        gate_ += (Uc*S*Up)*Tensor::Complex_i();
         }
     }
 
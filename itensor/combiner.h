@@ -108,13 +108,21 @@ class Combiner
     void 
     product(const ITensor& t, ITensor& res) const;
 
+    //Same as product for a t having the left indices, 
+    //but naming the combined Index grouped (which must
+    //have the size of right()); shares the data of t 
+    //when the left indices are adjacent in t
+    void
+    combine(const ITensor& t, const Index& grouped, ITensor& res) const
+        { init(); t.groupIndices(left_,rl_,grouped,res); }
+
     //For interface compatibility with IQCombiner
     void 
     doCondense(bool) { } 
 
 private:
 
-    boost::array<Index,NMAX+1> left_; // max dim is 8
+    boost::array<Index,NMAX+1> left_; // max dim is NMAX
     mutable Index right_;
     int rl_; //Number of m>1 'left' indices (indices to be combined into one)
     mutable bool initted;
@@ -136,10 +144,11 @@ Combiner(const Index& l1, const Index& l2,
     boost::array<const Index*,NMAX+1> ll 
     = {{ &Index::Null(), &l1, &l2, &l3, &l4, &l5, &l6, &l7, &l8 }};
 
+    //At most 8 indices are passed to this constructor
     do { ++rl_; left_[rl_] = *ll[rl_]; } 
-    while(rl_ < NMAX && *ll[rl_+1] != Index::Null());
+    while(rl_ < 8 && *ll[rl_+1] != Index::Null());
 
-    assert(rl_ == NMAX || left_[rl_+1] == Index::Null());
+    assert(rl_ == 8 || left_[rl_+1] == Index::Null());
     assert(left_[rl_] != Index::Null());
 	}
 
@@ -139,8 +139,8 @@ init(const std::string& smallind_name)
         Error("Arrow dirs not the same in Condenser.");
     }
     */
-    static std::vector<QN> qns(1000);
-    qns.resize(0);
+    std::vector<QN> qns;
+    qns.reserve(bigind_.nindex());
     Foreach(const IndexQN& x, bigind_.indices()) 
         qns.push_back(x.qn);
 
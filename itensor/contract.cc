@@ -0,0 +1,182 @@
+//
+// Distributed under the ITensor Library License, Version 1.0.
+//    (See accompanying LICENSE file.)
+//
+#include "contract.h"
+#include <algorithm>
+
+using namespace std;
+
+//
+// Labels of the indices of a group of tensors which are
+// not contracted within the group: those appearing an
+// odd number of times (labels are kept sorted)
+//
+static vector<int>
+openLabels(const vector<int>& a, const vector<int>& b)
+    {
+    vector<int> res;
+    set_symmetric_difference(a.begin(),a.end(),b.begin(),b.end(),
+                             back_inserter(res));
+    return res;
+    }
+
+//
+// Cost of contracting groups with open labels a and b:
+// the product of the sizes of all of their indices
+//
+static Real
+pairCost(const vector<int>& a, const vector<int>& b,
+         const vector<Real>& sizes)
+    {
+    vector<int> all;
+    set_union(a.begin(),a.end(),b.begin(),b.end(),back_inserter(all));
+    Real c = 1;
+    for(size_t l = 0; l < all.size(); ++l) c *= sizes.at(all[l]);
+    return c;
+    }
+
+static vector<vector<int> >
+sortedLabels(const vector<vector<int> >& labels)
+    {
+    vector<vector<int> > res(labels);
+    for(size_t t = 0; t < res.size(); ++t)
+        sort(res[t].begin(),res[t].end());
+    return res;
+    }
+
+ContractOrder::
+ContractOrder(const vector<vector<int> >& labels,
+              const vector<Real>& sizes,
+              const OptSet& opts)
+    : cost_(0)
+    {
+    const int exhaustive_max = opts.getInt("ExhaustiveMax",8);
+    if(int(labels.size()) <= exhaustive_max)
+        exhaustive(sortedLabels(labels),sizes);
+    else
+        greedy(sortedLabels(labels),sizes);
+    }
+
+Real ContractOrder::
+leftToRightCost(const vector<vector<int> >& labels,
+                const vector<Real>& sizes)
+    {
+    const vector<vector<int> > sl = sortedLabels(labels);
+    if(sl.empty()) return 0;
+    Real cost = 0;
+    vector<int> cur = sl.front();
+    for(size_t t = 1; t < sl.size(); ++t)
+        {
+        cost += pairCost(cur,sl[t],sizes);
+        cur = openLabels(cur,sl[t]);
+        }
+    return cost;
+    }
+
+//
+// Helper for exhaustive: appends the contractions
+// making up the group S, returning the tensor
+// (lowest in S) the group ends up in
+//
+static int
+emitSequence(int S, const vector<int>& split, ContractOrder::Sequence& seq)
+    {
+    const int A = split[S];
+    if(A == 0)
+        {
+        int t = 0;
+        while(!(S & (1 << t))) ++t;
+        return t;
+        }
+    const int i = emitSequence(A,split,seq),
+              j = emitSequence(S ^ A,split,seq);
+    seq.push_back(make_pair(min(i,j),max(i,j)));
+    return min(i,j);
+    }
+
+void ContractOrder::
+exhaustive(const vector<vector<int> >& labels,
+           const vector<Real>& sizes)
+    {
+    const int n = labels.size();
+    if(n < 2) return;
+    const int nsub = (1 << n);
+
+    //Open labels, best cost, and best split
+    //(one part of the pair) of each group S
+    vector<vector<int> > open(nsub);
+    vector<Real> best(nsub,0);
+    vector<int> split(nsub,0);
+
+    for(int S = 1; S < nsub; ++S)
+        {
+        const int low = (S & -S);
+        if(S == low)
+            {
+            int t = 0;
+            while(!(S & (1 << t))) ++t;
+            open[S] = labels[t];
+            continue;
+            }
+        open[S] = openLabels(open[low],open[S ^ low]);
+
+        //Each split is visited once by requiring
+        //the part A to contain the lowest tensor
+        best[S] = -1;
+        const int rest = S ^ low;
+        for(int B = rest; B > 0; B = (B-1) & rest)
+            {
+            const int A = S ^ B;
+            const Real c = best[A] + best[B] + pairCost(open[A],open[B],sizes);
+            if(best[S] < 0 || c < best[S])
+                {
+                best[S] = c;
+                split[S] = A;
+                }
+            }
+        }
+
+    cost_ = best[nsub-1];
+    emitSequence(nsub-1,split,seq_);
+    }
+
+void ContractOrder::
+greedy(const vector<vector<int> >& labels,
+       const vector<Real>& sizes)
+    {
+    const int n = labels.size();
+    vector<vector<int> > open(labels);
+    vector<bool> alive(n,true);
+
+    for(int step = 1; step < n; ++step)
+        {
+        int bi = -1, bj = -1;
+        bool bshared = false;
+        Real bcost = 0;
+        for(int i = 0; i < n; ++i)
+        for(int j = i+1; j < n; ++j)
+            {
+            if(!alive[i] || !alive[j]) continue;
+            vector<int> common;
+            set_intersection(open[i].begin(),open[i].end(),
+                             open[j].begin(),open[j].end(),
+                             back_inserter(common));
+            const bool shared = !common.empty();
+            const Real c = pairCost(open[i],open[j],sizes);
+            //Prefer pairs sharing an index over outer products
+            if(bi < 0 || (shared && !bshared)
+               || (shared == bshared && c < bcost))
+                {
+                bi = i;
+                bj = j;
+                bshared = shared;
+                bcost = c;
+                }
+            }
+        cost_ += bcost;
+        open[bi] = openLabels(open[bi],open[bj]);
+        alive[bj] = false;
+        seq_.push_back(make_pair(bi,bj));
+        }
+    }
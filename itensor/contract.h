@@ -0,0 +1,316 @@
+//
+// Distributed under the ITensor Library License, Version 1.0.
+//    (See accompanying LICENSE file.)
+//
+#ifndef __ITENSOR_CONTRACT_H
+#define __ITENSOR_CONTRACT_H
+#include "iqtensor.h"
+#include <map>
+
+//
+// ContractOrder
+//
+// Finds an order of pairwise contractions for a network
+// of tensors, given the labels of the indices of each
+// tensor (tensors sharing a label are contracted over it)
+// and the size of each label. The cost of contracting
+// two tensors is taken to be the product of the sizes
+// of all of their indices.
+//
+// For networks of up to ExhaustiveMax tensors (default 8)
+// the cost-optimal order is found by dynamic programming
+// over subsets of the tensors. Larger networks use a greedy
+// search, which always does the cheapest contraction
+// among the pairs of tensors sharing an index.
+//
+// The order is a list of pairs (i,j) with i < j, each
+// meaning that tensor j is contracted into tensor i.
+//
+
+class ContractOrder
+    {
+    public:
+
+    typedef std::vector<std::pair<int,int> >
+    Sequence;
+
+    ContractOrder() : cost_(0) { }
+
+    ContractOrder(const std::vector<std::vector<int> >& labels,
+                  const std::vector<Real>& sizes,
+                  const OptSet& opts = Global::opts());
+
+    const Sequence&
+    sequence() const { return seq_; }
+
+    //Total cost of the contractions in sequence()
+    Real
+    cost() const { return cost_; }
+
+    //Cost of contracting the tensors in the order given
+    static Real
+    leftToRightCost(const std::vector<std::vector<int> >& labels,
+                    const std::vector<Real>& sizes);
+
+    private:
+
+    /////////////////
+    //
+    // Data Members
+
+    Sequence seq_;
+
+    Real cost_;
+
+    //
+    /////////////////
+
+    void
+    exhaustive(const std::vector<std::vector<int> >& labels,
+               const std::vector<Real>& sizes);
+
+    void
+    greedy(const std::vector<std::vector<int> >& labels,
+           const std::vector<Real>& sizes);
+
+    }; //class ContractOrder
+
+//
+// Contractor
+//
+// Computes the product of several ITensors or IQTensors
+// using the order found by ContractOrder, for example
+//
+//     Contractor<IQTensor> C;
+//     IQTensor phip = C(phi,L,Op1,Op2,R);
+//
+// Orders are cached by the structure of the network (which
+// tensors share which indices, and the index sizes), so a
+// Contractor kept around for repeated products of the same
+// shape only searches for an order once. Each contraction
+// is done in place when one of the tensors involved is
+// already an intermediate, so at most one temporary per
+// input tensor is made.
+//
+// For IQTensors the size of an IQIndex is its total m,
+// so the order is optimal for the dense equivalent.
+//
+
+template <class Tensor>
+class Contractor
+    {
+    public:
+
+    typedef typename Tensor::IndexT
+    IndexT;
+
+    Contractor(const OptSet& opts = Global::opts())
+        : opts_(opts)
+        { }
+
+    void
+    contract(const std::vector<const Tensor*>& T, Tensor& res) const;
+
+    Tensor
+    operator()(const Tensor& A, const Tensor& B) const;
+
+    Tensor
+    operator()(const Tensor& A, const Tensor& B, const Tensor& C) const;
+
+    Tensor
+    operator()(const Tensor& A, const Tensor& B, const Tensor& C,
+               const Tensor& D) const;
+
+    Tensor
+    operator()(const Tensor& A, const Tensor& B, const Tensor& C,
+               const Tensor& D, const Tensor& E) const;
+
+    //Contraction order used for the tensors T
+    const ContractOrder&
+    order(const std::vector<const Tensor*>& T) const;
+
+    //Number of distinct network structures seen so far
+    int
+    numCached() const { return cache_.size(); }
+
+    private:
+
+    /////////////////
+    //
+    // Data Members
+
+    OptSet opts_;
+
+    mutable std::map<std::vector<int>,ContractOrder> cache_;
+
+    //
+    /////////////////
+
+    }; //class Contractor
+
+template <class Tensor>
+const ContractOrder& Contractor<Tensor>::
+order(const std::vector<const Tensor*>& T) const
+    {
+    //Label indices by order of first appearance; the
+    //structure key lists each tensor's (label,size) pairs
+    std::vector<IndexT> seen;
+    std::vector<std::vector<int> > labels(T.size());
+    std::vector<Real> sizes;
+    std::vector<int> key;
+    for(size_t t = 0; t < T.size(); ++t)
+        {
+        Foreach(const IndexT& I, T[t]->indices())
+            {
+            size_t l = 0;
+            while(l < seen.size() && !(seen[l] == I)) ++l;
+            if(l == seen.size())
+                {
+                seen.push_back(I);
+                sizes.push_back(I.m());
+                }
+            labels[t].push_back(l);
+            key.push_back(l);
+            key.push_back(I.m());
+            }
+        key.push_back(-1);
+        }
+
+    typename std::map<std::vector<int>,ContractOrder>::iterator
+    it = cache_.find(key);
+    if(it == cache_.end())
+        {
+        it = cache_.insert(std::make_pair(key,ContractOrder(labels,sizes,opts_))).first;
+        }
+    return it->second;
+    }
+
+template <class Tensor>
+void Contractor<Tensor>::
+contract(const std::vector<const Tensor*>& T, Tensor& res) const
+    {
+    const int n = T.size();
+    if(n == 0) Error("Contractor: no tensors given");
+    if(n == 1)
+        {
+        res = *T[0];
+        return;
+        }
+
+    const ContractOrder::Sequence& seq = order(T).sequence();
+
+    //cur[i] points to tensor i or to
+    //the intermediate which replaced it
+    std::vector<const Tensor*> cur(T);
+    std::vector<Tensor> tmp(n);
+    for(size_t s = 0; s < seq.size(); ++s)
+        {
+        const int i = seq[s].first,
+                  j = seq[s].second;
+        if(cur[i] == &tmp[i])
+            {
+            tmp[i] *= *cur[j];
+            }
+        else
+        if(cur[j] == &tmp[j])
+            {
+            tmp[j] *= *cur[i];
+            tmp[i].swap(tmp[j]);
+            }
+        else
+            {
+            tmp[i] = *cur[i];
+            tmp[i] *= *cur[j];
+            }
+        cur[i] = &tmp[i];
+        cur[j] = 0;
+        if(!tmp[j].isNull()) tmp[j] = Tensor();
+        }
+    res.swap(tmp[0]);
+    }
+
+template <class Tensor>
+Tensor Contractor<Tensor>::
+operator()(const Tensor& A, const Tensor& B) const
+    {
+    std::vector<const Tensor*> T;
+    T.push_back(&A);
+    T.push_back(&B);
+    Tensor res;
+    contract(T,res);
+    return res;
+    }
+
+template <class Tensor>
+Tensor Contractor<Tensor>::
+operator()(const Tensor& A, const Tensor& B, const Tensor& C) const
+    {
+    std::vector<const Tensor*> T;
+    T.push_back(&A);
+    T.push_back(&B);
+    T.push_back(&C);
+    Tensor res;
+    contract(T,res);
+    return res;
+    }
+
+template <class Tensor>
+Tensor Contractor<Tensor>::
+operator()(const Tensor& A, const Tensor& B, const Tensor& C,
+           const Tensor& D) const
+    {
+    std::vector<const Tensor*> T;
+    T.push_back(&A);
+    T.push_back(&B);
+    T.push_back(&C);
+    T.push_back(&D);
+    Tensor res;
+    contract(T,res);
+    return res;
+    }
+
+template <class Tensor>
+Tensor Contractor<Tensor>::
+operator()(const Tensor& A, const Tensor& B, const Tensor& C,
+           const Tensor& D, const Tensor& E) const
+    {
+    std::vector<const Tensor*> T;
+    T.push_back(&A);
+    T.push_back(&B);
+    T.push_back(&C);
+    T.push_back(&D);
+    T.push_back(&E);
+    Tensor res;
+    contract(T,res);
+    return res;
+    }
+
+//
+// Contract tensors in the optimal order
+// (no caching; use a Contractor for repeated products)
+//
+
+template <class Tensor>
+Tensor
+contract(const Tensor& A, const Tensor& B, const Tensor& C)
+    {
+    return Contractor<Tensor>()(A,B,C);
+    }
+
+template <class Tensor>
+Tensor
+contract(const Tensor& A, const Tensor& B, const Tensor& C,
+         const Tensor& D)
+    {
+    return Contractor<Tensor>()(A,B,C,D);
+    }
+
+template <class Tensor>
+Tensor
+contract(const Tensor& A, const Tensor& B, const Tensor& C,
+         const Tensor& D, const Tensor& E)
+    {
+    return Contractor<Tensor>()(A,B,C,D,E);
+    }
+
+#endif
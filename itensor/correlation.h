@@ -0,0 +1,94 @@
+//
+// Distributed under the ITensor Library License, Version 1.0.
+//    (See accompanying LICENSE file.)
+//
+#ifndef __ITENSOR_CORRELATION_H
+#define __ITENSOR_CORRELATION_H
+#include "mpsoverlap.h"
+
+//
+// Computes the one-point functions
+//
+//     res(i) = <psi|Op(i)|psi> / <psi|psi>
+//
+// for i = 1,...,N using a single set of cached
+// environments (no need to move the ortho center).
+//
+template <class Tensor>
+void
+localExpect(const MPSt<Tensor>& psi, SiteOpMethod Op, Vector& res)
+    {
+    const Model& model = psi.model();
+    const int N = psi.N();
+
+    MPSOverlap<Tensor> O(psi,psi);
+    const Real nrm2 = O.value();
+
+    res.ReDimension(N);
+    for(int i = 1; i <= N; ++i)
+        {
+        res(i) = O.expect(i,Tensor((model.*Op)(i)))/nrm2;
+        }
+    }
+
+//
+// Computes the two-point functions
+//
+//     C(i,j) = <psi|A(i) B(j)|psi> / <psi|psi>
+//
+// for all i,j = 1,...,N in a single O(N^2) pass.
+// On the diagonal the product A(i)B(i) is used.
+//
+// Options recognized:
+//     Fermionic - if true, A and B are fermionic operators
+//                 (such as &Model::Cdag and &Model::C) and
+//                 the Jordan-Wigner string made of the
+//                 Model's fermiPhase operators is included
+//                 (default false)
+//
+template <class Tensor>
+void
+correlationMatrix(const MPSt<Tensor>& psi,
+                  SiteOpMethod A, SiteOpMethod B,
+                  Matrix& Cre, Matrix& Cim,
+                  const OptSet& opts = Global::opts())
+    {
+    const Model& model = psi.model();
+    const int N = psi.N();
+    const bool fermionic = opts.getBool("Fermionic",false);
+
+    std::vector<Tensor> Aops(N+1),
+                        Bops(N+1),
+                        F;
+    for(int j = 1; j <= N; ++j)
+        {
+        Aops.at(j) = (model.*A)(j);
+        Bops.at(j) = (model.*B)(j);
+        }
+    if(fermionic)
+        {
+        F.resize(N+1);
+        for(int j = 1; j <= N; ++j)
+            F.at(j) = model.fermiPhase(j);
+        }
+
+    MPSOverlap<Tensor> O(psi,psi);
+    const Real nrm2 = O.value();
+
+    O.correlations(Aops,Bops,F,Cre,Cim);
+    Cre *= 1./nrm2;
+    Cim *= 1./nrm2;
+    }
+
+template <class Tensor>
+void
+correlationMatrix(const MPSt<Tensor>& psi,
+                  SiteOpMethod A, SiteOpMethod B,
+                  Matrix& C,
+                  const OptSet& opts = Global::opts())
+    {
+    Matrix Cim;
+    correlationMatrix(psi,A,B,C,Cim,opts);
+    }
+
+#endif
@@ -158,6 +158,24 @@ dmrg(MPSt<Tensor>& psi,
 
 
 
+//
+// Whether sweep sw should do the products of the
+// local Hamiltonian in single precision
+//
+// If the FloatProduct option is true, single precision
+// is used while the sweep's truncation cutoff is at least
+// FloatCutoff (default 1E-6). Sweeps with a smaller cutoff
+// need the energy to better than single precision and 
+// switch back to double precision.
+//
+inline bool
+sweepFloatProduct(const Sweeps& sweeps, int sw, 
+                  const OptSet& opts = Global::opts())
+    {
+    if(!opts.getBool("FloatProduct",false)) return false;
+    return sweeps.cutoff(sw) >= opts.getReal("FloatCutoff",1E-6);
+    }
+
 //
 // DMRGWorker
 //
@@ -197,6 +215,11 @@ DMRGWorker(MPSt<Tensor>& psi,
     psi.position(1);
 
     opts.add(Opt("DebugLevel",debug_level));
+
+    //The Davidson starting vector is a prediction which
+    //may already be converged, so let Davidson stop
+    //after one product unless told otherwise
+    opts.add(Opt("MinIter",opts.getInt("MinIter",0)));
     
     Eigensolver solver(opts);
 
@@ -210,6 +233,9 @@ DMRGWorker(MPSt<Tensor>& psi,
         psi.noise(sweeps.noise(sw));
         solver.maxIter(sweeps.niter(sw));
 
+        if(opts.getBool("FloatProduct",false))
+            PH.floatProduct(sweepFloatProduct(sweeps,sw,opts));
+
         if(!PH.doWrite() &&
             Global::opts().defined("WriteM") &&
             sweeps.maxm(sw) >= Global::opts().getInt("WriteM"))
@@ -226,6 +252,9 @@ DMRGWorker(MPSt<Tensor>& psi,
             PH.doWrite(true);
             }
 
+        int nproducts = 0,
+            nbonds = 0;
+
         for(int b = 1, ha = 1; ha <= 2; sweepnext(b,ha,N))
             {
             if(!quiet)
@@ -236,9 +265,16 @@ DMRGWorker(MPSt<Tensor>& psi,
 
             PH.position(b,psi);
 
+            //Since svdBond leaves the singular values in
+            //the orthogonality center, the bond tensor is
+            //the previous step's wavefunction transformed 
+            //to the new basis (White's prediction) and is 
+            //the Davidson starting vector
             Tensor phi = psi.bondTensor(b);
 
             energy = solver.davidson(PH,phi);
+            nproducts += solver.numProducts();
+            ++nbonds;
             
             psi.svdBond(b,phi,(ha==1?Fromleft:Fromright),PH,doNorm);
 
@@ -259,6 +295,12 @@ DMRGWorker(MPSt<Tensor>& psi,
             obs.measure(sw,ha,b,psi.svd(),energy);
 
             } //for loop over b
+
+        if(debug_level >= 2)
+            {
+            Cout << Format("    Davidson products in sweep %d: %d (%.1f per bond)")
+                    % sw % nproducts % (nproducts*1./nbonds) << Endl;
+            }
         
         if(obs.checkDone(sw,psi.svd(),energy)) break;
     
@@ -37,6 +37,20 @@ class Eigensolver
     // Returns the minimal eigenvalue lambda such that
     // A phi = lambda phi.
     //
+    // The initial phi is used as the first Krylov vector,
+    // so a good prediction (such as the bond tensor of an
+    // MPS after the previous SVD step of a DMRG sweep)
+    // converges in few iterations. If the residual of the
+    // initial phi is already below errgoal and minIter 
+    // is 0 (the default is 1, DMRG uses 0) davidson 
+    // returns after a single product.
+    //
+    // If maxSubspace is set (> 0) at most maxSubspace
+    // vectors are stored: once the basis is full it is
+    // replaced by the numRestart lowest Ritz vectors
+    // (thick restart) so that maxIter can be raised
+    // without increasing memory use.
+    //
     template <class LocalT, class Tensor> 
     Real 
     davidson(const LocalT& A, Tensor& phi) const;
@@ -73,6 +87,21 @@ class Eigensolver
     void 
     minIter(int val) { miniter_ = val; }
 
+    int
+    maxSubspace() const { return maxsub_; }
+    void
+    maxSubspace(int val) { maxsub_ = val; }
+
+    int
+    numRestart() const { return nrestart_; }
+    void
+    numRestart(int val) { nrestart_ = val; }
+
+    //Number of products A.product done
+    //by the last call to davidson
+    int
+    numProducts() const { return nproducts_; }
+
     int 
     debugLevel() const { return debug_level_; }
     void 
@@ -146,6 +175,13 @@ class Eigensolver
     Real errgoal_;
     int numget_;
     int debug_level_;
+    int maxsub_;
+    int nrestart_;
+    mutable int nproducts_;
+
+    //Workspace for the projected matrix
+    mutable Matrix MR_, 
+                   MI_;
 
     }; //class Eigensolver
 
@@ -153,9 +189,12 @@ class Eigensolver
 inline Eigensolver::
 Eigensolver(const OptSet& opts)
     : 
-    miniter_(1)
+    nproducts_(0)
     { 
     maxiter_ = opts.getInt("MaxIter",2);
+    miniter_ = opts.getInt("MinIter",1);
+    maxsub_ = opts.getInt("MaxSubspace",0);
+    nrestart_ = opts.getInt("NumRestart",2);
     errgoal_ = opts.getReal("ErrGoal",1E-4);
     numget_ = opts.getInt("NumGet",1);
     debug_level_ = opts.getInt("DebugLevel",-1);
@@ -180,12 +219,24 @@ davidson(const LocalT& A, Tensor& phi) const
                 % (maxsize-1) % maxiter_ % actual_maxiter << Endl;
         }
 
-    std::vector<Tensor> V(actual_maxiter+2),
-                       AV(actual_maxiter+2);
+    //Maximum number of basis vectors kept, and number of
+    //Ritz vectors kept when the basis is restarted
+    const int maxsub = (maxsub_ > 0 ? min(max(maxsub_,2),actual_maxiter+1) 
+                                    : actual_maxiter+1);
+    const int nrestart = max(1,min(nrestart_,maxsub-1));
+
+    std::vector<Tensor> V(maxsub+1),
+                       AV(maxsub+1);
 
     //Storage for Matrix that gets diagonalized 
-    Matrix MR(actual_maxiter+2,actual_maxiter+2),
-           MI(actual_maxiter+2,actual_maxiter+2);
+    //(kept between calls to avoid reallocating)
+    Matrix& MR = MR_;
+    Matrix& MI = MI_;
+    if(MR.Nrows() < maxsub+1)
+        {
+        MR.ReDimension(maxsub+1,maxsub+1);
+        MI.ReDimension(maxsub+1,maxsub+1);
+        }
     MR = NAN; //set to NAN to ensure failure if we use uninitialized elements
     MI = NAN;
 
@@ -193,6 +244,11 @@ davidson(const LocalT& A, Tensor& phi) const
     MatrixRef MrefR(MR.SubMatrix(1,1,1,1)),
               MrefI(MI.SubMatrix(1,1,1,1));
 
+    //Eigenvalues and eigenvectors of Mref
+    Vector D;
+    Matrix UR,
+           UI;
+
     //Get diagonal of A to use later
     const Tensor Adiag = A.diag();
 
@@ -202,6 +258,7 @@ davidson(const LocalT& A, Tensor& phi) const
 
     V[0] = phi;
     A.product(V[0],AV[0]);
+    nproducts_ = 1;
 
     Real re = NAN,
          im = NAN;
@@ -215,14 +272,16 @@ davidson(const LocalT& A, Tensor& phi) const
     const Real enshift = 0;
     //const Real enshift = initEn;
 
+    //Number of vectors in the basis V
+    int nv = 1;
+
     int iter = 0;
     for(int ii = 0; ii <= actual_maxiter; ++ii)
         {
         //Diagonalize conj(V)*A*V
         //and compute the residual q
 
-        const int ni = ii+1; 
-        Tensor& q = V.at(ni);
+        Tensor q;
 
         if(ii == 0)
             {
@@ -237,11 +296,8 @@ davidson(const LocalT& A, Tensor& phi) const
         else // ii != 0
             {
             //Diagonalize M
-            Vector D;
-            Matrix UR;
             if(complex_diag)
                 {
-                Matrix UI;
                 HermitianEigenvalues(MrefR,MrefI,D,UR,UI);
 
                 //Compute corresponding eigenvector
@@ -252,7 +308,7 @@ davidson(const LocalT& A, Tensor& phi) const
 
                 phi = (UR(1,1)*C1+UI(1,1)*Ci)*V[0];
                 q   = (UR(1,1)*C1+UI(1,1)*Ci)*AV[0];
-                for(int k = 1; k <= ii; ++k)
+                for(int k = 1; k < nv; ++k)
                     {
                     const Tensor cfac = (UR(k+1,1)*C1+UI(k+1,1)*Ci);
                     phi += cfac*V[k];
@@ -266,13 +322,8 @@ davidson(const LocalT& A, Tensor& phi) const
                 //Compute corresponding eigenvector
                 //phi of A from the min evec of M
                 //(and start calculating residual q)
-                phi = UR(1,1)*V[0];
-                q   = UR(1,1)*AV[0];
-                for(int k = 1; k <= ii; ++k)
-                    {
-                    phi += UR(k+1,1)*V[k];
-                    q   += UR(k+1,1)*AV[k];
-                    }
+                linearComb(V,UR.Column(1),phi);
+                linearComb(AV,UR.Column(1),q);
                 }
 
             //lambda is the minimum eigenvalue of M
@@ -312,14 +363,19 @@ davidson(const LocalT& A, Tensor& phi) const
             goto done;
             }
 
-        const bool converged = (qnorm < errgoal_ && fabs(lambda-last_lambda) < errgoal_) 
+        //On the first step there is no previous lambda 
+        //to compare to, so rely on the residual alone
+        //(the error of lambda is of order qnorm^2)
+        {
+        const bool lambda_conv = (ii == 0 || fabs(lambda-last_lambda) < errgoal_);
+        const bool converged = (qnorm < errgoal_ && lambda_conv) 
                                || qnorm < max(1E-12,errgoal_ * 1.0e-3);
 
         if((converged && ii >= miniter_) || (ii == actual_maxiter))
             {
             if(debug_level_ >= 3) //Explain why breaking out of Davidson loop early
                 {
-                if((qnorm < errgoal_ && fabs(lambda-last_lambda) < errgoal_))
+                if((qnorm < errgoal_ && lambda_conv))
                     Cout << "Breaking out of Davidson because errgoal reached" << Endl;
                 else
                 if(qnorm < max(1E-12,errgoal_ * 1.0e-3) && ii >= miniter_)
@@ -330,6 +386,7 @@ davidson(const LocalT& A, Tensor& phi) const
                 }
             goto done;
             }
+        }
         
         if(debug_level_ >= 2 || (ii == 0 && debug_level_ >= 1))
             {
@@ -342,6 +399,54 @@ davidson(const LocalT& A, Tensor& phi) const
 
         if(ii < actual_maxiter)
             {
+            if(nv == maxsub)
+                {
+                //Thick restart: replace the basis by the
+                //nrestart lowest Ritz vectors, in which
+                //M is diagonal
+                if(debug_level_ >= 2)
+                    {
+                    Cout << Format("Restarting Davidson keeping %d of %d vectors")
+                            % nrestart % nv << Endl;
+                    }
+                std::vector<Tensor> nV(nrestart),
+                                    nAV(nrestart);
+                for(int j = 1; j <= nrestart; ++j)
+                    {
+                    if(complex_diag)
+                        {
+                        const Tensor& C1 = Tensor::Complex_1();
+                        const Tensor& Ci = Tensor::Complex_i();
+                        const Tensor cfac0 = (UR(1,j)*C1+UI(1,j)*Ci);
+                        nV[j-1] = cfac0*V[0];
+                        nAV[j-1] = cfac0*AV[0];
+                        for(int k = 1; k < nv; ++k)
+                            {
+                            const Tensor cfac = (UR(k+1,j)*C1+UI(k+1,j)*Ci);
+                            nV[j-1] += cfac*V[k];
+                            nAV[j-1] += cfac*AV[k];
+                            }
+                        }
+                    else
+                        {
+                        linearComb(V,UR.Column(j),nV[j-1]);
+                        linearComb(AV,UR.Column(j),nAV[j-1]);
+                        }
+                    }
+                for(int k = 0; k < nv; ++k)
+                    {
+                    V[k] = (k < nrestart ? nV[k] : Tensor());
+                    AV[k] = (k < nrestart ? nAV[k] : Tensor());
+                    }
+                nv = nrestart;
+
+                MrefR << MR.SubMatrix(1,nv,1,nv);
+                MrefI << MI.SubMatrix(1,nv,1,nv);
+                MrefR = 0;
+                MrefI = 0;
+                MrefR.Diagonal() = D.SubVector(1,nv);
+                }
+
             //On all but last step,
             //compute next Krylov/trial vector by
             //first applying Davidson preconditioner
@@ -359,19 +464,19 @@ davidson(const LocalT& A, Tensor& phi) const
             //Do Gram-Schmidt on d (Npass times)
             //to include it in the subbasis
             const int Npass = 2;
-            std::vector<Real> rVq(ni,NAN),
-                              iVq(ni,NAN);
+            std::vector<Real> rVq(nv,NAN),
+                              iVq(nv,NAN);
 
             int count = 0;
             for(int pass = 1; pass <= Npass; ++pass)
                 {
                 ++count;
-                for(int k = 0; k < ni; ++k)
+                for(int k = 0; k < nv; ++k)
                     {
                     BraKet(V[k],q,rVq[k],iVq[k]);
                     }
 
-                for(int k = 0; k < ni; ++k)
+                for(int k = 0; k < nv; ++k)
                     {
                     q += (-rVq[k])*V[k];
                     if(iVq[k] != 0)
@@ -388,13 +493,13 @@ davidson(const LocalT& A, Tensor& phi) const
                     //try randomizing
                     if(debug_level_ >= 2)
                         Cout << "Vector not independent, randomizing" << Endl;
-                    q = V.at(ni-1);
+                    q = V.at(nv-1);
                     q.randomize();
 
                     //Don't want to count real and imaginary parts as independent
                     //from the point of view of orthogonalization
                     const int cplxVecSize = q.vecSize() / (isComplex(q) ? 2 : 1);
-                    if(cplxVecSize <= ni)
+                    if(cplxVecSize <= nv)
                         {
                         //Not be possible to orthogonalize if
                         //max size of q (vecSize after randomize)
@@ -411,50 +516,37 @@ davidson(const LocalT& A, Tensor& phi) const
                 q *= 1./qn;
                 }
 
-
-            /*
-            if(debug_level_ >= 4)
-                {
-                //Check V's are orthonormal
-                Matrix Vo(ni+1,ni+1); 
-                Vo = NAN;
-                for(int r = 1; r <= ni+1; ++r)
-                for(int c = r; c <= ni+1; ++c)
-                    {
-                    Vo(r,c) = Dot(conj(V[r-1]),V[c-1]);
-                    Vo(c,r) = Vo(r,c);
-                    }
-                Print(Vo);
-                }
-            */
-
             last_lambda = lambda;
 
             //Expand AV and M
             //for next step
-            A.product(V[ni],AV[ni]);
+            V[nv] = q;
+            A.product(V[nv],AV[nv]);
+            ++nproducts_;
 
             //Add new row and column to M
-            MrefR << MR.SubMatrix(1,ni+1,1,ni+1);
-            MrefI << MI.SubMatrix(1,ni+1,1,ni+1);
-            Vector newColR(ni+1),
-                   newColI(ni+1);
-            for(int k = 0; k <= ni; ++k)
+            MrefR << MR.SubMatrix(1,nv+1,1,nv+1);
+            MrefI << MI.SubMatrix(1,nv+1,1,nv+1);
+            Vector newColR(nv+1),
+                   newColI(nv+1);
+            for(int k = 0; k <= nv; ++k)
                 {
-                BraKet(V.at(k),AV.at(ni),
+                BraKet(V.at(k),AV.at(nv),
                        newColR(k+1),
                        newColI(k+1));
                 }
-            newColR(ni+1) -= enshift;
+            newColR(nv+1) -= enshift;
 
-            MrefR.Column(ni+1) = newColR;
-            MrefR.Row(ni+1) = newColR;
+            MrefR.Column(nv+1) = newColR;
+            MrefR.Row(nv+1) = newColR;
 
             if(!complex_diag && Norm(newColI) > errgoal_)
                 { complex_diag = true; }
 
-            MrefI.Column(ni+1) = newColI;
-            MrefI.Row(ni+1) = -newColI;
+            MrefI.Column(nv+1) = newColI;
+            MrefI.Row(nv+1) = -newColI;
+
+            ++nv;
 
             } //if ii < actual_maxiter
 
@@ -467,10 +559,10 @@ davidson(const LocalT& A, Tensor& phi) const
     if(debug_level_ >= 3)
         {
         //Check V's are orthonormal
-        Matrix Vo_final(iter+1,iter+1); 
+        Matrix Vo_final(nv,nv); 
         Vo_final = NAN;
-        for(int r = 1; r <= iter+1; ++r)
-        for(int c = r; c <= iter+1; ++c)
+        for(int r = 1; r <= nv; ++r)
+        for(int c = r; c <= nv; ++c)
             {
             BraKet(V[r-1],V[c-1],re,im);
             Vo_final(r,c) = re;
@@ -490,7 +582,6 @@ davidson(const LocalT& A, Tensor& phi) const
         }
 
     return lambda;
-
     } //Eigensolver::davidson
 
 template <class LocalTA, class LocalTB, class Tensor> 
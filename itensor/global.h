@@ -18,7 +18,20 @@
 #include "boost/foreach.hpp"
 #define Foreach BOOST_FOREACH
 
-static const int NMAX = 8;
+//
+// Maximum number of indices of a tensor.
+// To work with tensors of higher rank, define
+// ITENSOR_NMAX (for example -DITENSOR_NMAX=12 
+// in OPTIMIZATIONS and DEBUGFLAGS in options.mk)
+// when building the library and your code.
+// Tensors of rank 8 or less use the same unrolled 
+// loops whatever the value of NMAX; larger ones 
+// fall back on loops over the dimensions.
+//
+#ifndef ITENSOR_NMAX
+#define ITENSOR_NMAX 8
+#endif
+static const int NMAX = ITENSOR_NMAX;
 static const Real MIN_CUT = 1E-20;
 static const int MAX_M = 5000;
 
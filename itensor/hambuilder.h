@@ -94,6 +94,246 @@ class HamBuilder
 
     };
 
+//
+//
+// MPOTensorBuilder
+//
+// Accumulates the elements of an MPO tensor W, each 
+// a site operator times a coefficient placed at a 
+// given (row,col) of the link indices, such as
+//
+//     MPOTensorBuilder<ITensor> B(row,col);
+//     B.add(1,1,model.id(n));
+//     B.add(k,2,model.sz(n),J);
+//     ...
+//     B.build(W);
+//
+// which is equivalent to
+//
+//     W += model.id(n) * row(1) * col(1);
+//     W += model.sz(n) * row(k) * col(2) * J;
+//     ...
+//
+// but allocates W (or each QN block of W for an 
+// IQTensor) only once and writes the elements 
+// directly instead of adding full-size products.
+//
+// row or col may be Null (for an edge tensor) in
+// which case only row (or col) 1 may be used.
+// For an IQTensor, row and col should be given with
+// the arrow directions they will have in W.
+//
+
+template <class Tensor>
+class MPOTensorBuilder
+    {
+    public:
+
+    typedef typename Tensor::IndexT
+    IndexT;
+
+    MPOTensorBuilder(const IndexT& row, const IndexT& col)
+        : row_(row), col_(col)
+        { }
+
+    //Adds coef * op to the (r,c) element of W
+    void
+    add(int r, int c, const Tensor& op, Real coef = 1);
+
+    int
+    numEntries() const { return entries_.size(); }
+
+    //Sets W to the sum of the entries; W has the
+    //indices of the operators and the row and col indices
+    void
+    build(Tensor& W) const;
+
+    private:
+
+    struct Entry
+        {
+        int r, c;
+        Tensor op;
+        Real coef;
+
+        Entry(int r_, int c_, const Tensor& op_, Real coef_)
+            : r(r_), c(c_), op(op_), coef(coef_)
+            { }
+        };
+
+    /////////////////
+    //
+    // Data Members
+
+    IndexT row_, 
+           col_;
+
+    std::vector<Entry> entries_;
+
+    //
+    /////////////////
+
+    }; //class MPOTensorBuilder
+
+template <class Tensor>
+void MPOTensorBuilder<Tensor>::
+add(int r, int c, const Tensor& op, Real coef)
+    {
+    const int kr = (row_ == IndexT::Null() ? 1 : row_.m()),
+              kc = (col_ == IndexT::Null() ? 1 : col_.m());
+    if(r < 1 || r > kr || c < 1 || c > kc)
+        {
+        Print(r);
+        Print(c);
+        Error("MPOTensorBuilder: row or col out of range");
+        }
+    if(coef == 0) return;
+    entries_.push_back(Entry(r,c,op,coef));
+    }
+
+template <>
+void inline MPOTensorBuilder<ITensor>::
+build(ITensor& W) const
+    {
+    if(entries_.empty()) Error("MPOTensorBuilder: no entries");
+
+    const ITensor& op0 = entries_.front().op;
+    if(op0.r() != 2) Error("MPOTensorBuilder: operators must have two indices");
+    const Index& i1 = op0.indices().index(1);
+    const Index& i2 = op0.indices().index(2);
+
+    IndexSet<Index> inds(i1,i2);
+    if(row_ != Index::Null()) inds.addindex(row_);
+    if(col_ != Index::Null()) inds.addindex(col_);
+
+    //Element (a,b,r,c) of W is at 
+    //a + d1*(b + d2*(r + kr*c)) (zero based)
+    const int d1 = i1.m(),
+              d2 = i2.m(),
+              kr = (row_ == Index::Null() ? 1 : row_.m());
+
+    Vector V(inds.dim());
+    V = 0;
+    Matrix M;
+    Foreach(const Entry& e, entries_)
+        {
+        e.op.toMatrix11(i1,i2,M);
+        const int start = 1 + d1*d2*((e.r-1) + kr*(e.c-1));
+        for(int b = 1; b <= d2; ++b)
+        for(int a = 1; a <= d1; ++a)
+            {
+            V(start+(a-1)+d1*(b-1)) += e.coef*M(a,b);
+            }
+        }
+
+    W = ITensor(inds,V);
+    }
+
+template <>
+void inline MPOTensorBuilder<IQTensor>::
+build(IQTensor& W) const
+    {
+    if(entries_.empty()) Error("MPOTensorBuilder: no entries");
+
+    std::vector<IQIndex> iqinds;
+    Foreach(const IQIndex& I, entries_.front().op.indices())
+        iqinds.push_back(I);
+    if(iqinds.size() != 2) Error("MPOTensorBuilder: operators must have two indices");
+    if(row_ != IQIndex::Null()) iqinds.push_back(row_);
+    if(col_ != IQIndex::Null()) iqinds.push_back(col_);
+
+    W = IQTensor(iqinds);
+
+    //The Index of row_ (col_) containing each
+    //row (col) and the position within it
+    std::vector<Index> rind(1,Index::Null()),
+                       cind(1,Index::Null());
+    std::vector<int> rpos(1,0),
+                     cpos(1,0);
+    if(row_ == IQIndex::Null())
+        {
+        rind.push_back(Index::Null());
+        rpos.push_back(1);
+        }
+    else
+        {
+        Foreach(const IndexQN& x, row_.indices())
+        for(int j = 1; j <= x.m(); ++j)
+            {
+            rind.push_back(x);
+            rpos.push_back(j);
+            }
+        }
+    if(col_ == IQIndex::Null())
+        {
+        cind.push_back(Index::Null());
+        cpos.push_back(1);
+        }
+    else
+        {
+        Foreach(const IndexQN& x, col_.indices())
+        for(int j = 1; j <= x.m(); ++j)
+            {
+            cind.push_back(x);
+            cpos.push_back(j);
+            }
+        }
+
+    //Index's and data of each block of W, 
+    //keyed by the block's uniqueReal
+    std::map<ApproxReal,IndexSet<Index> > binds;
+    std::map<ApproxReal,Vector> bdat;
+    Matrix M;
+    Foreach(const Entry& e, entries_)
+        {
+        const Index& ri = rind.at(e.r);
+        const Index& ci = cind.at(e.c);
+
+        //Position of (e.r,e.c) within the (ri,ci) part of a block
+        const int kr = (ri == Index::Null() ? 1 : ri.m());
+        const int rc = (rpos.at(e.r)-1) + kr*(cpos.at(e.c)-1);
+
+        Foreach(const ITensor& ob, e.op.blocks())
+            {
+            const Index& a = ob.indices().index(1);
+            const Index& b = ob.indices().index(2);
+
+            Real ur = ob.uniqueReal();
+            if(ri != Index::Null()) ur += ri.uniqueReal();
+            if(ci != Index::Null()) ur += ci.uniqueReal();
+
+            Vector& V = bdat[ur];
+            if(V.Length() == 0)
+                {
+                IndexSet<Index> inds(a,b);
+                if(ri != Index::Null()) inds.addindex(ri);
+                if(ci != Index::Null()) inds.addindex(ci);
+                V.ReDimension(inds.dim());
+                V = 0;
+                binds[ur] = inds;
+                }
+
+            //Element (ia,ib,r,c) of the block is at
+            //ia + ma*(ib + mb*rc) (zero based)
+            const int ma = a.m(),
+                      mb = b.m();
+            const int start = 1 + ma*mb*rc;
+            ob.toMatrix11(a,b,M);
+            for(int ib = 1; ib <= mb; ++ib)
+            for(int ia = 1; ia <= ma; ++ia)
+                {
+                V(start+(ia-1)+ma*(ib-1)) += e.coef*M(ia,ib);
+                }
+            }
+        }
+
+    for(std::map<ApproxReal,Vector>::const_iterator it = bdat.begin();
+        it != bdat.end(); ++it)
+        {
+        W += ITensor(binds[it->first],it->second);
+        }
+    }
+
 inline HamBuilder::
 HamBuilder(const Model& mod)
     :
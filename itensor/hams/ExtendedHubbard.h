@@ -4,7 +4,7 @@
 //
 #ifndef __ITENSOR_HAMS_EXTENDEDHUBBARD_H
 #define __ITENSOR_HAMS_EXTENDEDHUBBARD_H
-#include "../mpo.h"
+#include "../hambuilder.h"
 #include "../model/hubbard.h"
 
 class ExtendedHubbard
@@ -91,52 +91,54 @@ init_()
         ITensor& W = H.Anc(n);
         Index &row = links[n-1], &col = links[n];
 
-        W = ITensor(model_.si(n),model_.siP(n),row,col);
+        MPOTensorBuilder<ITensor> B(row,col);
 
         //Identity strings
-        W += model_.id(n) * row(1) * col(1);
-        W += model_.id(n) * row(k) * col(k);
+        B.add(1,1,model_.id(n));
+        B.add(k,k,model_.id(n));
 
         //Hubbard U term
-        W += model_.Nupdn(n) * row(k) * col(1) * U_;
+        B.add(k,1,model_.Nupdn(n),U_);
 
         //Hubbard V1 term
-        W += model_.Ntot(n) * row(k-1) * col(1);
-        W += model_.Ntot(n) * row(k) * col(k-1) * V1_;
+        B.add(k-1,1,model_.Ntot(n));
+        B.add(k,k-1,model_.Ntot(n),V1_);
 
         if(t2_ == 0)
             {
             //Kinetic energy/hopping terms, defined as -t_*(c^d_i c_{i+1} + h.c.)
-            W += multSiteOps(model_.fermiPhase(n),model_.Cup(n)) * row(k) * col(2) * t1_;
-            W += multSiteOps(model_.fermiPhase(n),model_.Cdn(n)) * row(k) * col(3) * t1_;
-            W += multSiteOps(model_.Cdagup(n),model_.fermiPhase(n)) * row(k) * col(4) * t1_;
-            W += multSiteOps(model_.Cdagdn(n),model_.fermiPhase(n)) * row(k) * col(5) * t1_;
-
-            W += model_.Cdagup(n) * row(2) * col(1) * (-1.0);
-            W += model_.Cdagdn(n) * row(3) * col(1) * (-1.0);
-            W += model_.Cup(n) * row(4) * col(1) * (-1.0);
-            W += model_.Cdn(n) * row(5) * col(1) * (-1.0);
+            B.add(k,2,multSiteOps(model_.fermiPhase(n),model_.Cup(n)),t1_);
+            B.add(k,3,multSiteOps(model_.fermiPhase(n),model_.Cdn(n)),t1_);
+            B.add(k,4,multSiteOps(model_.Cdagup(n),model_.fermiPhase(n)),t1_);
+            B.add(k,5,multSiteOps(model_.Cdagdn(n),model_.fermiPhase(n)),t1_);
+
+            B.add(2,1,model_.Cdagup(n),-1.0);
+            B.add(3,1,model_.Cdagdn(n),-1.0);
+            B.add(4,1,model_.Cup(n),-1.0);
+            B.add(5,1,model_.Cdn(n),-1.0);
             }
         else // t2_ != 0
             {
-            W += multSiteOps(model_.fermiPhase(n),model_.Cup(n)) * row(k) * col(2) * t1_;
-            W += multSiteOps(model_.fermiPhase(n),model_.Cup(n)) * row(k) * col(3) * t2_;
-            W += multSiteOps(model_.fermiPhase(n),model_.Cdn(n)) * row(k) * col(4) * t1_;
-            W += multSiteOps(model_.fermiPhase(n),model_.Cdn(n)) * row(k) * col(5) * t2_;
-            W += multSiteOps(model_.Cdagup(n),model_.fermiPhase(n)) * row(k) * col(6) * t1_;
-            W += multSiteOps(model_.Cdagup(n),model_.fermiPhase(n)) * row(k) * col(7) * t2_;
-            W += multSiteOps(model_.Cdagdn(n),model_.fermiPhase(n)) * row(k) * col(8) * t1_;
-            W += multSiteOps(model_.Cdagdn(n),model_.fermiPhase(n)) * row(k) * col(9) * t2_;
-
-            W += model_.Cdagup(n)*row(2)*col(1)*(-1.0);
-            W += model_.fermiPhase(n)*row(3)*col(2);
-            W += model_.Cdagdn(n)*row(4)*col(1)*(-1.0);
-            W += model_.fermiPhase(n)*row(5)*col(4);
-            W += model_.Cup(n)*row(6)*col(1)*(-1.0);
-            W += model_.fermiPhase(n)*row(7)*col(6);
-            W += model_.Cdn(n)*row(8)*col(1)*(-1.0);
-            W += model_.fermiPhase(n)*row(9)*col(8);
+            B.add(k,2,multSiteOps(model_.fermiPhase(n),model_.Cup(n)),t1_);
+            B.add(k,3,multSiteOps(model_.fermiPhase(n),model_.Cup(n)),t2_);
+            B.add(k,4,multSiteOps(model_.fermiPhase(n),model_.Cdn(n)),t1_);
+            B.add(k,5,multSiteOps(model_.fermiPhase(n),model_.Cdn(n)),t2_);
+            B.add(k,6,multSiteOps(model_.Cdagup(n),model_.fermiPhase(n)),t1_);
+            B.add(k,7,multSiteOps(model_.Cdagup(n),model_.fermiPhase(n)),t2_);
+            B.add(k,8,multSiteOps(model_.Cdagdn(n),model_.fermiPhase(n)),t1_);
+            B.add(k,9,multSiteOps(model_.Cdagdn(n),model_.fermiPhase(n)),t2_);
+
+            B.add(2,1,model_.Cdagup(n),-1.0);
+            B.add(3,2,model_.fermiPhase(n));
+            B.add(4,1,model_.Cdagdn(n),-1.0);
+            B.add(5,4,model_.fermiPhase(n));
+            B.add(6,1,model_.Cup(n),-1.0);
+            B.add(7,6,model_.fermiPhase(n));
+            B.add(8,1,model_.Cdn(n),-1.0);
+            B.add(9,8,model_.fermiPhase(n));
             }
+
+        B.build(W);
         }
 
     H.Anc(1) *= ITensor(links.at(0)(k));
@@ -5,7 +5,7 @@
 #ifndef __ITENSOR_HAMS_HEISENBERG_H
 #define __ITENSOR_HAMS_HEISENBERG_H
 
-#include "../mpo.h"
+#include "../hambuilder.h"
 
 #define Cout std::cout
 #define Endl std::endl
@@ -35,7 +35,19 @@ class Heisenberg
 
     operator MPO() { init_(); return H; }
 
-    operator IQMPO() { init_(); return H; }
+    operator IQMPO() 
+        { 
+        init_(); 
+        if(infinite_) Error("Infinite option only supported for MPO");
+        return H; 
+        }
+
+    //Boundary tensors capping off the MPO if the
+    //Infinite option is set (for use with idmrg)
+    const ITensor&
+    HL() { init_(); return HL_; }
+    const ITensor&
+    HR() { init_(); return HR_; }
 
     private:
 
@@ -48,8 +60,10 @@ class Heisenberg
         Nx_;
     Real J_, 
          Boundary_h_;
+    bool infinite_;
     bool initted_;
     MPO H;
+    ITensor HL_, HR_;
 
     //
     //////////////////
@@ -69,6 +83,7 @@ Heisenberg(const Model& model, const OptSet& opts)
     Nx_ = model_.N()/Ny_;
     J_ = opts.getReal("J",1.);
     Boundary_h_ = opts.getReal("Boundary_h",0.);
+    infinite_ = opts.getBool("Infinite",false);
     }
 
 void inline Heisenberg::
@@ -91,20 +106,20 @@ init_()
         ITensor& W = H.Anc(n);
         Index &row = links.at(n-1), &col = links.at(n);
 
-        W = ITensor(model_.si(n),model_.siP(n),row,col);
+        MPOTensorBuilder<ITensor> B(row,col);
 
-        W += model_.id(n) * row(1) * col(1);
-        W += model_.id(n) * row(k) * col(k);
+        B.add(1,1,model_.id(n));
+        B.add(k,k,model_.id(n));
 
-        W += model_.sz(n) * row(2) * col(1);
-        W += model_.sp(n) * row(3) * col(1);
-        W += model_.sm(n) * row(4) * col(1);
+        B.add(2,1,model_.sz(n));
+        B.add(3,1,model_.sp(n));
+        B.add(4,1,model_.sm(n));
 
         //Horizontal bonds
         int mpo_dist = Ny_; 
-        W += model_.sz(n) * row(k) * col(2+nop*(mpo_dist-1)) * J_;
-        W += model_.sm(n) * row(k) * col(3+nop*(mpo_dist-1)) * J_/2;
-        W += model_.sp(n) * row(k) * col(4+nop*(mpo_dist-1)) * J_/2;
+        B.add(k,2+nop*(mpo_dist-1),model_.sz(n),J_);
+        B.add(k,3+nop*(mpo_dist-1),model_.sm(n),J_/2);
+        B.add(k,4+nop*(mpo_dist-1),model_.sp(n),J_/2);
 
         //Add boundary field if requested
         const int x = (n-1)/Ny_+1, y = (n-1)%Ny_+1;
@@ -113,35 +128,42 @@ init_()
             Real eff_h = Boundary_h_;
             if(J_ > 0) eff_h *= (x%2==1 ? -1 : 1)*(y%2==1 ? -1 : 1);
             //cerr << format("Doing a staggered bf of %.2f at site %d (%d,%d)\n")%eff_h%n%x%y;
-            W += model_.sz(n) * ITensor(row(k),col(1)) * eff_h;
+            B.add(k,1,model_.sz(n),eff_h);
             }
 
         //The following only apply if Ny_ > 1:
 
         //String of identity ops
         for(int q = 1; q <= nop*(max_mpo_dist-1); ++q)
-            { W += model_.id(n) * row(1+nop+q) * col(1+q); }
+            { B.add(1+nop+q,1+q,model_.id(n)); }
 
         //Periodic BC bond (only for width 3 ladders or greater)
         if(y == 1 && Ny_ >= 3)
             {
             int mpo_dist = Ny_-1; 
-            W += model_.sz(n) * row(k) * col(2+nop*(mpo_dist-1)) * J_;
-            W += model_.sm(n) * row(k) * col(3+nop*(mpo_dist-1)) * J_/2;
-            W += model_.sp(n) * row(k) * col(4+nop*(mpo_dist-1)) * J_/2;
+            B.add(k,2+nop*(mpo_dist-1),model_.sz(n),J_);
+            B.add(k,3+nop*(mpo_dist-1),model_.sm(n),J_/2);
+            B.add(k,4+nop*(mpo_dist-1),model_.sp(n),J_/2);
             }
 
         //N.N. bond along column
         if(y != Ny_)
             {
-            W += model_.sz(n) * row(k) * col(2) * J_;
-            W += model_.sm(n) * row(k) * col(3) * J_/2;
-            W += model_.sp(n) * row(k) * col(4) * J_/2;
+            B.add(k,2,model_.sz(n),J_);
+            B.add(k,3,model_.sm(n),J_/2);
+            B.add(k,4,model_.sp(n),J_/2);
             }
+
+        B.build(W);
         }
 
-    H.Anc(1) *= ITensor(links.at(0)(k));
-    H.Anc(Ns) *= ITensor(links.at(Ns)(1));
+    HL_ = ITensor(links.at(0)(k));
+    HR_ = ITensor(links.at(Ns)(1));
+    if(!infinite_)
+        {
+        H.Anc(1) *= HL_;
+        H.Anc(Ns) *= HR_;
+        }
 
     initted_ = true;
     }
@@ -4,7 +4,7 @@
 //
 #ifndef __ITENSOR_HAMS_HUBBARDCHAIN_H
 #define __ITENSOR_HAMS_HUBBARDCHAIN_H
-#include "../mpo.h"
+#include "../hambuilder.h"
 #include "../model/hubbard.h"
 
 class HubbardChain
@@ -77,24 +77,26 @@ init_()
         ITensor& W = H.Anc(n);
         Index &row = links[n-1], &col = links[n];
 
-        W = ITensor(model_.si(n),model_.siP(n),row,col);
+        MPOTensorBuilder<ITensor> B(row,col);
 
         //Identity strings
-        W += model_.id(n) * row(1) * col(1);
-        W += model_.id(n) * row(k) * col(k);
+        B.add(1,1,model_.id(n));
+        B.add(k,k,model_.id(n));
 
         //Hubbard U
-        W += model_.Nupdn(n) * row(k) * col(1) * U_;
+        B.add(k,1,model_.Nupdn(n),U_);
 
         //Kinetic energy/hopping terms, defined as -t_*(c^d_i c_{i+1} + h.c.)
-        W += multSiteOps(model_.fermiPhase(n),model_.Cup(n)) * row(k) * col(2) * t_;
-        W += multSiteOps(model_.fermiPhase(n),model_.Cdn(n)) * row(k) * col(3) * t_;
-        W += multSiteOps(model_.Cdagup(n),model_.fermiPhase(n)) * row(k) * col(4) * t_;
-        W += multSiteOps(model_.Cdagdn(n),model_.fermiPhase(n)) * row(k) * col(5) * t_;
-        W += model_.Cdagup(n) * row(2) * col(1) * (-1.0);
-        W += model_.Cdagdn(n) * row(3) * col(1) * (-1.0);
-        W += model_.Cup(n) * row(4) * col(1) * (-1.0);
-        W += model_.Cdn(n) * row(5) * col(1) * (-1.0);
+        B.add(k,2,multSiteOps(model_.fermiPhase(n),model_.Cup(n)),t_);
+        B.add(k,3,multSiteOps(model_.fermiPhase(n),model_.Cdn(n)),t_);
+        B.add(k,4,multSiteOps(model_.Cdagup(n),model_.fermiPhase(n)),t_);
+        B.add(k,5,multSiteOps(model_.Cdagdn(n),model_.fermiPhase(n)),t_);
+        B.add(2,1,model_.Cdagup(n),-1.0);
+        B.add(3,1,model_.Cdagdn(n),-1.0);
+        B.add(4,1,model_.Cup(n),-1.0);
+        B.add(5,1,model_.Cdn(n),-1.0);
+
+        B.build(W);
         }
 
     H.Anc(1) *= ITensor(links.at(0)(k));
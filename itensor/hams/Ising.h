@@ -4,7 +4,7 @@
 //
 #ifndef __ITENSOR_HAMS_ISING_H
 #define __ITENSOR_HAMS_ISING_H
-#include "../mpo.h"
+#include "../hambuilder.h"
 
 #define Cout std::cout
 #define Endl std::endl
@@ -91,22 +91,22 @@ init_()
         ITensor& W = H.Anc(n);
         Index &row = links[n-1], &col = links[n];
 
-        W = ITensor(model_.si(n),model_.siP(n),row,col);
+        MPOTensorBuilder<ITensor> B(row,col);
 
-        W += model_.id(n) * row(1) * col(1);
-        W += model_.id(n) * row(k) * col(k);
+        B.add(1,1,model_.id(n));
+        B.add(k,k,model_.id(n));
 
-        W += model_.sz(n) * row(2) * col(1);
+        B.add(2,1,model_.sz(n));
 
         //Transverse field
         if(hx_ != 0)
             {
-            W += model_.sx(n) * row(k) * col(1) * hx_;
+            B.add(k,1,model_.sx(n),hx_);
             }
 
         //Horizontal bonds (N.N in 1d)
         int mpo_dist = Ny_; 
-        W += model_.sz(n) * row(k) * col(2+(mpo_dist-1)) * J_;
+        B.add(k,2+(mpo_dist-1),model_.sz(n),J_);
 
         //
         //The following only apply if ny_ > 1:
@@ -114,21 +114,23 @@ init_()
 
         //String of identity ops
         for(int q = 1; q <= (max_mpo_dist-1); ++q)
-            { W += model_.id(n) * row(2+q) * col(1+q); }
+            { B.add(2+q,1+q,model_.id(n)); }
 
         //Periodic BC bond
         const int y = (n-1)%Ny_+1;
         if(y == 1 && Ny_ > 2)
             {
             int mpo_dist = Ny_-1; 
-            W += model_.sz(n) * row(k) * col(2+(mpo_dist-1)) * J_;
+            B.add(k,2+(mpo_dist-1),model_.sz(n),J_);
             }
 
         //N.N. bond along column
         if(y != Ny_)
             {
-            W += model_.sz(n) * row(k) * col(2) * J_;
+            B.add(k,2,model_.sz(n),J_);
             }
+
+        B.build(W);
         }
 
     H.Anc(1) *= ITensor(links.at(0)(k));
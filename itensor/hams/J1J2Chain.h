@@ -4,7 +4,7 @@
 //
 #ifndef __ITENSOR_HAMS_J1J2CHAIN_H
 #define __ITENSOR_HAMS_J1J2CHAIN_H
-#include "../mpo.h"
+#include "../hambuilder.h"
 
 class J1J2Chain
     {
@@ -92,29 +92,31 @@ init()
         IQIndex row = conj(iqlinks.at(j-1)),
                 col = iqlinks.at(j);
 
-        W = IQTensor(conj(model_.si(j)),model_.siP(j),row,col);
+        MPOTensorBuilder<IQTensor> B(row,col);
 
         //Identity string operators
-        W += model_.id(j) * row(ds) * col(ds);
-        W += model_.id(j) * row(k) * col(k);
+        B.add(ds,ds,model_.id(j));
+        B.add(k,k,model_.id(j));
 
         //S+ S- terms
-        W += model_.sp(j) * row(k) * col(1) * (J1_/2.);
-        W += model_.sp(j) * row(k) * col(2) * (J2_/2.);
-        W += model_.id(j) * row(2) * col(1);
-        W += model_.sm(j) * row(1) * col(ds);
+        B.add(k,1,model_.sp(j),J1_/2.);
+        B.add(k,2,model_.sp(j),J2_/2.);
+        B.add(2,1,model_.id(j));
+        B.add(1,ds,model_.sm(j));
 
         //S- S+ terms
-        W += model_.sm(j) * row(k) * col(3) * (J1_/2.);
-        W += model_.sm(j) * row(k) * col(4) * (J2_/2.);
-        W += model_.id(j) * row(4) * col(3);
-        W += model_.sp(j) * row(3) * col(ds);
+        B.add(k,3,model_.sm(j),J1_/2.);
+        B.add(k,4,model_.sm(j),J2_/2.);
+        B.add(4,3,model_.id(j));
+        B.add(3,ds,model_.sp(j));
 
         //Sz Sz terms
-        W += model_.sz(j) * row(k) * col(6) * J1_;
-        W += model_.sz(j) * row(k) * col(7) * J2_;
-        W += model_.id(j) * row(7) * col(6);
-        W += model_.sz(j) * row(6) * col(ds);
+        B.add(k,6,model_.sz(j),J1_);
+        B.add(k,7,model_.sz(j),J2_);
+        B.add(7,6,model_.id(j));
+        B.add(6,ds,model_.sz(j));
+
+        B.build(W);
         }
 
     H.Anc(1) *= IQTensor(iqlinks.at(0)(k));
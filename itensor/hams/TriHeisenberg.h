@@ -4,7 +4,7 @@
 //
 #ifndef __ITENSOR_HAMS_TRIANGULARHEISENBERG_H
 #define __ITENSOR_HAMS_TRIANGULARHEISENBERG_H
-#include "../mpo.h"
+#include "../hambuilder.h"
 
 class TriangularHeisenberg
     {
@@ -78,20 +78,20 @@ init_()
         ITensor& W = H.Anc(n);
         Index &row = links[n-1], &col = links[n];
 
-        W = ITensor(model_.si(n),model_.siP(n),row,col);
+        MPOTensorBuilder<ITensor> B(row,col);
 
-        W += model_.id(n) * row(1) * col(1);
-        W += model_.id(n) * row(k) * col(k);
+        B.add(1,1,model_.id(n));
+        B.add(k,k,model_.id(n));
 
-        W += model_.sz(n) * row(2) * col(1);
-        W += model_.sp(n) * row(3) * col(1);
-        W += model_.sm(n) * row(4) * col(1);
+        B.add(2,1,model_.sz(n));
+        B.add(3,1,model_.sp(n));
+        B.add(4,1,model_.sm(n));
 
         //Horizontal bonds, connect n -> n+Ny_
         int mpo_dist = Ny_; 
-        W += model_.sz(n) * row(k) * col(2+nop*(mpo_dist-1)) * J_;
-        W += model_.sm(n) * row(k) * col(3+nop*(mpo_dist-1)) * J_/2;
-        W += model_.sp(n) * row(k) * col(4+nop*(mpo_dist-1)) * J_/2;
+        B.add(k,2+nop*(mpo_dist-1),model_.sz(n),J_);
+        B.add(k,3+nop*(mpo_dist-1),model_.sm(n),J_/2);
+        B.add(k,4+nop*(mpo_dist-1),model_.sp(n),J_/2);
 
         //Add boundary field if requested
         const int x = (n-1)/Ny_+1, y = (n-1)%Ny_+1;
@@ -100,38 +100,40 @@ init_()
             Real eff_h = boundary_h_;
             eff_h *= ((x+y-2)%3==0 ? -1 : 0.5);
             std::cout << boost::format("Applying a pinning field of %.2f at site %d (%d,%d)\n")%eff_h%n%x%y;
-            W += model_.sz(n) * ITensor(row(k),col(1)) * eff_h;
+            B.add(k,1,model_.sz(n),eff_h);
             }
 
         //The following only apply if Ny_ > 1:
 
         //String of identity ops
         for(int q = 1; q <= nop*(max_mpo_dist-1); ++q)
-            { W += model_.id(n) * row(1+nop+q) * col(1+q); }
+            { B.add(1+nop+q,1+q,model_.id(n)); }
 
         //Square lattice periodic BC bond
         //Connects n -> n+(Ny_-1)
         if(y == 1)
             {
             mpo_dist = Ny_-1; 
-            W += model_.sz(n) * row(k) * col(2+nop*(mpo_dist-1)) * J_;
-            W += model_.sm(n) * row(k) * col(3+nop*(mpo_dist-1)) * J_/2;
-            W += model_.sp(n) * row(k) * col(4+nop*(mpo_dist-1)) * J_/2;
+            B.add(k,2+nop*(mpo_dist-1),model_.sz(n),J_);
+            B.add(k,3+nop*(mpo_dist-1),model_.sm(n),J_/2);
+            B.add(k,4+nop*(mpo_dist-1),model_.sp(n),J_/2);
             }
 
         //N.N. bond along column
-        W += model_.sz(n) * row(k) * col(2) * J_;
-        W += model_.sm(n) * row(k) * col(3) * J_/2;
-        W += model_.sp(n) * row(k) * col(4) * J_/2;
+        B.add(k,2,model_.sz(n),J_);
+        B.add(k,3,model_.sm(n),J_/2);
+        B.add(k,4,model_.sp(n),J_/2);
 
         //Diagonal bonds
         if(y != Ny_)
             {
             mpo_dist = Ny_+1; 
-            W += model_.sz(n) * row(k) * col(2+nop*(mpo_dist-1)) * J_;
-            W += model_.sm(n) * row(k) * col(3+nop*(mpo_dist-1)) * J_/2;
-            W += model_.sp(n) * row(k) * col(4+nop*(mpo_dist-1)) * J_/2;
+            B.add(k,2+nop*(mpo_dist-1),model_.sz(n),J_);
+            B.add(k,3+nop*(mpo_dist-1),model_.sm(n),J_/2);
+            B.add(k,4+nop*(mpo_dist-1),model_.sp(n),J_/2);
             }
+
+        B.build(W);
         }
 
     H.Anc(1) *= ITensor(links.at(0)(k));
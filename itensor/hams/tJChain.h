@@ -4,7 +4,7 @@
 //
 #ifndef __ITENSOR_HAMS_TJCHAIN_H
 #define __ITENSOR_HAMS_TJCHAIN_H
-#include "../mpo.h"
+#include "../hambuilder.h"
 
 #define Cout std::cout
 #define Endl std::endl
@@ -75,36 +75,38 @@ init_()
         ITensor& W = H.Anc(n);
         Index &row = links[n-1], &col = links[n];
 
-        W = ITensor(model_.si(n),model_.siP(n),row,col);
+        MPOTensorBuilder<ITensor> B(row,col);
 
 	// fermiPhase will be needed for longer range hopping, but not for this nn chain
 
-        //W += model_.Nupdn(n) * row(k) * col(1) * U_;	
-        //W += multSiteOps(model_.fermiPhase(n),model_.Cup(n)) * row(k) * col(2) * t_;
-        //W += multSiteOps(model_.fermiPhase(n),model_.Cdn(n)) * row(k) * col(3) * t_;
-        //W += multSiteOps(model_.Cdagup(n),model_.fermiPhase(n)) * row(k) * col(4) * t_;
-        //W += multSiteOps(model_.Cdagdn(n),model.fermiPhase(n)) * row(k) * col(5) * t_;
-
-        W += model_.Cup(n) * row(k) * col(2) * t_;
-        W += model_.Cdn(n) * row(k) * col(3) * t_;
-        W += model_.Cdagup(n) * row(k) * col(4) * t_;
-        W += model_.Cdagdn(n) * row(k) * col(5) * t_;
-
-        W += model_.sz(n) * row(k) * col(6) * J_;
-        W += model_.sp(n) * row(k) * col(7) * J_/2;
-        W += model_.sm(n) * row(k) * col(8) * J_/2;
-        W += model_.Ntot(n) * row(k) * col(9) * (-J_/4);
-        W += model_.id(n) * row(k) * col(k);
-
-        W += model_.id(n) * row(1) * col(1);
-        W += model_.Cdagup(n) * row(2) * col(1) * (-1.0);
-        W += model_.Cdagdn(n) * row(3) * col(1) * (-1.0);
-        W += model_.Cup(n) * row(4) * col(1) * (-1.0);
-        W += model_.Cdn(n) * row(5) * col(1) * (-1.0);
-        W += model_.sz(n) * row(6) * col(1);
-        W += model_.sm(n) * row(7) * col(1);
-        W += model_.sp(n) * row(8) * col(1);
-        W += model_.Ntot(n) * row(9) * col(1);
+        //B.add(k,1,model_.Nupdn(n),U_);	
+        //B.add(k,2,multSiteOps(model_.fermiPhase(n),model_.Cup(n)),t_);
+        //B.add(k,3,multSiteOps(model_.fermiPhase(n),model_.Cdn(n)),t_);
+        //B.add(k,4,multSiteOps(model_.Cdagup(n),model_.fermiPhase(n)),t_);
+        //B.add(k,5,multSiteOps(model_.Cdagdn(n),model.fermiPhase(n)),t_);
+
+        B.add(k,2,model_.Cup(n),t_);
+        B.add(k,3,model_.Cdn(n),t_);
+        B.add(k,4,model_.Cdagup(n),t_);
+        B.add(k,5,model_.Cdagdn(n),t_);
+
+        B.add(k,6,model_.sz(n),J_);
+        B.add(k,7,model_.sp(n),J_/2);
+        B.add(k,8,model_.sm(n),J_/2);
+        B.add(k,9,model_.Ntot(n),-J_/4);
+        B.add(k,k,model_.id(n));
+
+        B.add(1,1,model_.id(n));
+        B.add(2,1,model_.Cdagup(n),-1.0);
+        B.add(3,1,model_.Cdagdn(n),-1.0);
+        B.add(4,1,model_.Cup(n),-1.0);
+        B.add(5,1,model_.Cdn(n),-1.0);
+        B.add(6,1,model_.sz(n));
+        B.add(7,1,model_.sm(n));
+        B.add(8,1,model_.sp(n));
+        B.add(9,1,model_.Ntot(n));
+
+        B.build(W);
         }
 
     H.Anc(1) *= ITensor(links.at(0)(k));
@@ -0,0 +1,286 @@
+//
+// Distributed under the ITensor Library License, Version 1.0.
+//    (See accompanying LICENSE file.)
+//
+#ifndef __ITENSOR_IDMRG_H
+#define __ITENSOR_IDMRG_H
+
+#include "dmrg.h"
+
+#define Cout std::cout
+#define Endl std::endl
+#define Format boost::format
+
+//
+// Infinite DMRG (iDMRG)
+//
+// H is an MPO for two unit cells of Nuc sites each
+// (N = 2*Nuc sites) made of bulk tensors, so that
+// H.A(1) has a left link index and H.A(N) a right
+// link index which are capped off by the boundary
+// tensors LH and RH (as in dmrg(psi,H,LH,RH,...)).
+// H.A(j) and H.A(Nuc+j) must be identical up to their
+// indices. See for example the Infinite option of
+// the Heisenberg class in hams/Heisenberg.h.
+//
+// Each step does one sweep over the 2*Nuc sites, then
+// absorbs the left and right unit cells into LH and RH
+// (so the system grows by 2*Nuc sites) and inserts two
+// new unit cells in the middle. The new cells are
+// initialized with McCulloch's prediction
+// (arxiv:0804.2509)
+//
+//   psi = [D B_{Nuc+1}...B_N] D_{prev}^{-1} [A_1...A_Nuc D]
+//
+// where A (B) are the left (right) orthogonal tensors
+// of the previous step and D (D_prev) are the center
+// singular values of the current (previous) step.
+// Since this guess is close to the fixed point, each
+// step needs only a few Davidson iterations.
+//
+// The number of steps and the truncation parameters
+// of each step are given by sweeps. The returned value,
+// and the energy passed to the Observer, is the energy
+// per site estimated from the energy added in the most
+// recent step. On return psi holds the last two unit cells.
+//
+
+//
+// Relabel the index i of T as j
+// (i and j must have the same size and, for an IQIndex,
+// the same QN sectors)
+//
+inline void
+relabelIndex(ITensor& T, const Index& i, const Index& j)
+    {
+    T *= ITensor(i,j,1);
+    }
+
+inline void
+relabelIndex(IQTensor& T, const IQIndex& i, const IQIndex& j)
+    {
+    Foreach(const IQIndex& I, T.indices())
+        {
+        if(!(I == i)) continue;
+        IQIndex J(j);
+        if(J.dir() != I.dir()) J.conj();
+        IQTensor delta(conj(I),J);
+        for(int k = 1; k <= I.nindex(); ++k)
+            delta += ITensor(I.index(k),J.index(k),1);
+        T *= delta;
+        return;
+        }
+    Print(i);
+    Error("relabelIndex: index not found");
+    }
+
+//
+// Returns the Link index of T not shared with other
+//
+template <class Tensor>
+typename Tensor::IndexT
+uniqueLink(const Tensor& T, const Tensor& other)
+    {
+    typedef typename Tensor::IndexT
+    IndexT;
+    Foreach(const IndexT& I, T.indices())
+        {
+        if(I.type() == Link && !hasindex(other,I)) return I;
+        }
+    Error("uniqueLink: no unique Link index found");
+    return IndexT();
+    }
+
+template <class Tensor>
+Real
+idmrg(MPSt<Tensor>& psi,
+      const MPOt<Tensor>& H,
+      const Tensor& LH, const Tensor& RH,
+      const Sweeps& sweeps,
+      Observer& obs,
+      OptSet opts = Global::opts())
+    {
+    typedef typename Tensor::IndexT
+    IndexT;
+    typedef typename Tensor::SparseT
+    SparseT;
+
+    const int N = psi.N();
+    if(N%2 != 0 || H.N() != N)
+        Error("idmrg: MPS and MPO must have an even number 2*Nuc of sites");
+    const int Nuc = N/2;
+
+    const Real orig_cutoff = psi.cutoff(),
+               orig_noise  = psi.noise();
+    const int orig_minm = psi.minm(),
+              orig_maxm = psi.maxm();
+
+    const bool quiet = opts.getBool("Quiet",false);
+    const int debug_level = opts.getInt("DebugLevel",(quiet ? 0 : 1));
+    opts.add(Opt("DebugLevel",debug_level));
+
+    Eigensolver solver(opts);
+    const Opt doNorm = DoNormalize(true);
+
+    //MPO link indices at the edges and the middle
+    //of the two unit cells
+    const IndexT hl0 = uniqueLink(H.A(1),H.A(2)),
+                 hlN = uniqueLink(H.A(N),H.A(N-1)),
+                 hlc = commonIndex(H.A(Nuc),H.A(Nuc+1),Link);
+
+    Tensor HL(LH),
+           HR(RH);
+    SparseT lastD;
+
+    Real energy = NAN,
+         last_energy = 0,
+         energy_per_site = NAN;
+
+    psi.position(1);
+
+    for(int sw = 1; sw <= sweeps.nsweep(); ++sw)
+        {
+        psi.cutoff(sweeps.cutoff(sw));
+        psi.minm(sweeps.minm(sw));
+        psi.maxm(sweeps.maxm(sw));
+        psi.noise(sweeps.noise(sw));
+        solver.maxIter(sweeps.niter(sw));
+
+        //
+        // Optimize the two unit cells in the current environment
+        //
+        LocalMPO<Tensor> PH(H,HL,HR,opts);
+        PH.floatProduct(sweepFloatProduct(sweeps,sw,opts));
+
+        for(int b = 1, ha = 1; ha <= 2; sweepnext(b,ha,N))
+            {
+            if(!quiet)
+                {
+                Cout << Format("iDMRG Step=%d, HS=%d, Bond=(%d,%d)")
+                        % sw % ha % b % (b+1) << Endl;
+                }
+
+            PH.position(b,psi);
+
+            Tensor phi = psi.bondTensor(b);
+
+            energy = solver.davidson(PH,phi);
+            energy_per_site = (energy-last_energy)/N;
+
+            psi.svdBond(b,phi,(ha==1?Fromleft:Fromright),PH,doNorm);
+
+            if(!quiet)
+                {
+                Cout << Format("    Trunc. err=%.1E, States kept=%s")
+                        % psi.svd().truncerr(b)
+                        % showm(psi.LinkInd(b))
+                        << Endl;
+                }
+
+            obs.measure(sw,ha,b,psi.svd(),energy_per_site);
+            }
+
+        if(!quiet)
+            {
+            Cout << Format("    Energy per site after step %d is %.12f")
+                    % sw % energy_per_site << Endl;
+            }
+
+        if(obs.checkDone(sw,psi.svd(),energy_per_site)) break;
+        if(sw == sweeps.nsweep()) break;
+
+        last_energy = energy;
+
+        //
+        // Split off the center singular values
+        //
+        psi.position(Nuc);
+        Tensor U = psi.A(Nuc),
+               V;
+        SparseT D;
+        psi.svd().svd(Nuc,psi.A(Nuc)*psi.A(Nuc+1),U,D,V);
+        D *= 1./D.norm();
+        psi.Anc(Nuc) = U;
+        psi.Anc(Nuc+1) = V;
+
+        //
+        // Absorb the unit cells into the edge tensors
+        //
+        for(int j = 1; j <= Nuc; ++j)
+            {
+            psi.leftLim(j);
+            projectOp(psi,j,Fromleft,HL,H.A(j),HL);
+            }
+        for(int j = N; j > Nuc; --j)
+            {
+            psi.rightLim(j);
+            projectOp(psi,j,Fromright,HR,H.A(j),HR);
+            }
+        relabelIndex(HL,hlc,hl0);
+        relabelIndex(HR,hlc,hlN);
+
+        //
+        // Swap the unit cells and insert the
+        // singular values to predict the next state
+        //
+        std::vector<Tensor> Acell(Nuc+1),
+                            Bcell(Nuc+1);
+        for(int j = 1; j <= Nuc; ++j)
+            {
+            Acell.at(j) = psi.A(j);
+            Bcell.at(j) = psi.A(Nuc+j);
+            }
+        Bcell.at(1) *= D;
+        Acell.at(Nuc) *= D;
+        if(!lastD.isNull())
+            {
+            //Connects the right link of B_N to the
+            //left link of A_1 (no link on the first step)
+            lastD.pseudoInvert(0);
+            Acell.at(1) *= lastD;
+            }
+        lastD = D;
+
+        for(int j = 1; j <= Nuc; ++j)
+            {
+            const IndexT sj = psi.si(j),
+                         sjc = psi.si(Nuc+j);
+            relabelIndex(Bcell.at(j),sjc,sj);
+            relabelIndex(Acell.at(j),sj,sjc);
+            psi.Anc(j) = Bcell.at(j);
+            psi.Anc(Nuc+j) = Acell.at(j);
+            }
+
+        //Mark psi as not orthogonalized
+        psi.leftLim(0);
+        psi.rightLim(N+1);
+        psi.position(1);
+        }
+
+    psi.cutoff(orig_cutoff);
+    psi.minm(orig_minm);
+    psi.maxm(orig_maxm);
+    psi.noise(orig_noise);
+
+    psi.normalize();
+
+    return energy_per_site;
+    }
+
+template <class Tensor>
+Real
+idmrg(MPSt<Tensor>& psi,
+      const MPOt<Tensor>& H,
+      const Tensor& LH, const Tensor& RH,
+      const Sweeps& sweeps,
+      const OptSet& opts = Global::opts())
+    {
+    DMRGObserver obs;
+    return idmrg(psi,H,LH,RH,sweeps,obs,opts);
+    }
+
+#undef Cout
+#undef Endl
+#undef Format
+
+#endif
@@ -149,7 +149,14 @@ generateUniqueReal()
     //Construct rng and seed with address of seed
     static Generator rng((uintptr_t)&seed);
 
-    return rng();
+    //rng is shared, so calls from multiple 
+    //threads (e.g. in gateTEvol) must take turns
+    Real r;
+#ifdef _OPENMP
+#pragma omp critical (generateUniqueReal)
+#endif
+    r = rng();
+    return r;
     }
 
 
@@ -196,6 +203,9 @@ rawname() const { return p->sname; }
 Real Index::
 uniqueReal() const { return p->ur*(1+(primelevel_/10.)); }
 
+Real Index::
+rawUniqueReal() const { return p->ur; }
+
 bool Index::
 isNull() const { return (p == IndexDat::Null()); }
 
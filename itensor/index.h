@@ -67,6 +67,11 @@ class Index
     Real 
     uniqueReal() const;
 
+    // Returns a unique Real number shared by all copies
+    // of this Index, regardless of their primeLevel.
+    Real
+    rawUniqueReal() const;
+
     // Returns the IndexType
     IndexType 
     type() const;
@@ -15,6 +15,13 @@
 //
 // IndexSet
 //
+// Besides the indices themselves, an IndexSet keeps flat
+// copies of the data identifying each index (its
+// rawUniqueReal, prime level and dimension). Comparisons,
+// lookups and m(j) use these, so they do not need to
+// dereference the IndexDat shared by copies of an Index.
+// Copying an IndexSet only copies its first r() indices.
+//
 
 template <class IndexT>
 class IndexSet
@@ -44,6 +51,11 @@ class IndexSet
 
     IndexSet(const IndexSet& other, const Permutation& P);
 
+    IndexSet(const IndexSet& other);
+
+    IndexSet&
+    operator=(const IndexSet& other);
+
     //
     // Type definitions
     //
@@ -77,7 +89,7 @@ class IndexSet
     size() const { return r_; }
 
     int
-    m(int j) const { return GET(index_,j-1).m(); }
+    m(int j) const { return GET(m_,j-1); }
 
     int
     dim() const;
@@ -93,6 +105,20 @@ class IndexSet
     Real
     uniqueReal() const { return ur_; }
 
+    //Position (0-based, as for operator[]) of I
+    //in this IndexSet, or -1 if not found
+    int
+    find(const IndexT& I) const;
+
+    //True if index(j) of this IndexSet equals
+    //other.index(k) (j and k are 1-based)
+    bool
+    same(int j, const IndexSet& other, int k) const
+        { 
+        return (id_[j-1] == other.id_[k-1] 
+                && plev_[j-1] == other.plev_[k-1]);
+        }
+
     //
     // Primelevel Methods
     //
@@ -157,11 +183,36 @@ class IndexSet
 
     Real ur_;
 
+    //Flat copies of index_[j].rawUniqueReal(),
+    //index_[j].primeLevel() and index_[j].m()
+    Array<Real,NMAX> id_;
+
+    Array<int,NMAX> plev_,
+                    m_;
+
     //
     /////////
 
     void
-    setUniqueReal();
+    setKey(int j)
+        {
+        const IndexT& J = index_[j];
+        id_[j] = J.rawUniqueReal();
+        plev_[j] = J.primeLevel();
+        m_[j] = J.m();
+        }
+
+    void
+    copyKey(int j, const IndexSet& other, int k)
+        {
+        id_[j] = other.id_[k];
+        plev_[j] = other.plev_[k];
+        m_[j] = other.m_[k];
+        }
+
+    //Sets the keys of all indices and ur_
+    void
+    setKeys();
 
     template <class Iterable>
     void
@@ -191,6 +242,7 @@ IndexSet(const IndexT& i1)
         Error("i1 is null");
 #endif
     index_[0] = i1;
+    setKey(0);
     }
 
 template<class IndexT>
@@ -218,6 +270,8 @@ IndexSet(const IndexT& i1, const IndexT& i2)
         index_[1] = i2; 
 	    rn_ = (i2.m() == 1 ? 1 : 2); 
 	    }
+    setKey(0);
+    setKey(1);
     }
 
 template<class IndexT>
@@ -240,7 +294,7 @@ IndexSet(IndexT i1, IndexT i2, IndexT i3,
 	while(ii[r_] != IndexT::Null()) ++r_;
     int alloc_size;
     sortIndices(ii,r_,alloc_size,0);
-    setUniqueReal();
+    setKeys();
     }
 
 template <class IndexT>
@@ -251,7 +305,7 @@ IndexSet(const Iterable& ii, int size, int offset)
     r_ = (size < 0 ? ii.size() : size);
     int alloc_size = -1;
     sortIndices(ii,r_,alloc_size,offset);
-    setUniqueReal();
+    setKeys();
     }
 
 template <class IndexT>
@@ -262,7 +316,7 @@ IndexSet(const Iterable& ii, int size, int& alloc_size, int offset)
     r_(size)
     { 
     sortIndices(ii,size,alloc_size,offset);
-    setUniqueReal();
+    setKeys();
     }
 
 
@@ -275,7 +329,41 @@ IndexSet(const IndexSet& other, const Permutation& P)
     ur_(other.ur_)
     {
     for(int j = 1; j <= r_; ++j)
+        {
         index_[P.dest(j)-1] = other.index_[j-1];
+        copyKey(P.dest(j)-1,other,j-1);
+        }
+    }
+
+template <class IndexT>
+IndexSet<IndexT>::
+IndexSet(const IndexSet& other)
+    :
+    rn_(other.rn_),
+    r_(other.r_),
+    ur_(other.ur_)
+    {
+    for(int j = 0; j < r_; ++j)
+        {
+        index_[j] = other.index_[j];
+        copyKey(j,other,j);
+        }
+    }
+
+template <class IndexT>
+IndexSet<IndexT>& IndexSet<IndexT>::
+operator=(const IndexSet& other)
+    {
+    if(this == &other) return *this;
+    rn_ = other.rn_;
+    r_ = other.r_;
+    ur_ = other.ur_;
+    for(int j = 0; j < r_; ++j)
+        {
+        index_[j] = other.index_[j];
+        copyKey(j,other,j);
+        }
+    return *this;
     }
 
 template <class IndexT>
@@ -284,10 +372,23 @@ dim() const
     {   
     int d = 1;
     for(int j = 0; j < rn_; ++j)
-        d *= index_[j].m();
+        d *= m_[j];
     return d;
     }
 
+template <class IndexT>
+int IndexSet<IndexT>::
+find(const IndexT& I) const
+    {
+    const Real id = I.rawUniqueReal();
+    const int plev = I.primeLevel();
+    for(int j = (I.m() == 1 ? rn_ : 0); j < r_; ++j)
+        {
+        if(id_[j] == id && plev_[j] == plev) return j;
+        }
+    return -1;
+    }
+
 
 
 template <class IndexT>
@@ -301,15 +402,20 @@ noprime(IndexType type)
 #ifdef DEBUG
         //Check if calling noprime is ok
         //Error if it causes duplicate indices
+        //(only indices of the given type are unprimed)
+        if(type == All || J.type() == type)
         for(int k = 0; k < r_; ++k)
             {
-            if(k != j && index_[j].noprimeEquals(index_[k]))
+            if(k != j 
+               && (type == All || index_[k].type() == type)
+               && index_[j].noprimeEquals(index_[k]))
                 {
                 throw ITError("Calling noprime leads to duplicate indices");
                 }
             }
 #endif
         J.noprime(type);
+        setKey(j);
         ur_ += J.uniqueReal();
         }
 	}
@@ -318,27 +424,25 @@ template <class IndexT>
 void IndexSet<IndexT>::
 noprime(const IndexT& I)
     {
-    int j = (I.m() == 1 ? rn_ : 0);
-    for(; j < r_; ++j) 
+    const int j = find(I);
+    if(j >= 0)
         {
-        if(index_[j] == I)
-            {
 #ifdef DEBUG
-            //Check if calling noprime is ok
-            //Error if it causes duplicate indices
-            for(int k = 0; k < r_; ++k)
+        //Check if calling noprime is ok
+        //Error if it causes duplicate indices
+        for(int k = 0; k < r_; ++k)
+            {
+            if(k != j && id_[j] == id_[k])
                 {
-                if(k != j && index_[j].noprimeEquals(index_[k]))
-                    {
-                    throw ITError("Calling noprime leads to duplicate indices");
-                    }
+                throw ITError("Calling noprime leads to duplicate indices");
                 }
-#endif
-            index_[j].noprime();
-            ur_ -= I.uniqueReal();
-            ur_ += index_[j].uniqueReal();
-            return;
             }
+#endif
+        index_[j].noprime();
+        setKey(j);
+        ur_ -= I.uniqueReal();
+        ur_ += index_[j].uniqueReal();
+        return;
         }
     Print(*this);
     Print(I);
@@ -354,6 +458,7 @@ prime(IndexType type, int inc)
         {
         IndexT& J = index_[j];
         J.prime(type,inc);
+        setKey(j);
         ur_ += J.uniqueReal();
         }
 	}
@@ -362,10 +467,11 @@ template <class IndexT>
 void IndexSet<IndexT>::
 prime(const IndexT& I, int inc)
     {
-    for(int j = (I.m() == 1 ? rn_ : 0); j < r_; ++j) 
-        if(index_[j] == I)
+    const int j = find(I);
+    if(j >= 0)
         {
         index_[j].prime(inc);
+        setKey(j);
         ur_ -= I.uniqueReal();
         ur_ += index_[j].uniqueReal();
         return;
@@ -384,6 +490,7 @@ mapprime(int plevold, int plevnew, IndexType type)
         {
         IndexT& J = index_[j];
         J.mapprime(plevold,plevnew,type);
+        setKey(j);
         ur_ += J.uniqueReal();
         }
 	}
@@ -402,17 +509,17 @@ addindex(const IndexT& I)
         Error("Maximum number of indices reached");
     if(I == IndexT::Null())
         Error("Index is null");
-    for(int j = (I.m()==1?rn_:0); j < r_; ++j)
-        if(index_[j] == I)
-            {
-            Print(*this);
-            Print(I);
-            Error("Adding Index twice");
-            }
+    if(find(I) >= 0)
+        {
+        Print(*this);
+        Print(I);
+        Error("Adding Index twice");
+        }
 #endif
     if(I.m() == 1)
         {
         index_[r_] = I;
+        setKey(r_);
         }
     else
         {
@@ -420,9 +527,13 @@ addindex(const IndexT& I)
             {
             //Move all m==1's over by 1
             for(int k = r_; k > rn_; --k)
+                {
                 index_[k] = index_[k-1];
+                copyKey(k,*this,k-1);
+                }
             }
         index_[rn_] = I;
+        setKey(rn_);
         ++rn_;
         }
     ++r_;
@@ -473,11 +584,14 @@ addindex1(const std::vector<IndexT>& indices)
 
 template <class IndexT>
 void IndexSet<IndexT>::
-setUniqueReal()
+setKeys()
 	{
     ur_ = 0;
     for(int j = 0; j < r_; ++j)
+        {
+        setKey(j);
         ur_ += index_[j].uniqueReal();
+        }
 	}
 
 template <class IndexT>
@@ -497,6 +611,10 @@ swap(IndexSet& other)
     Real rtmp = ur_;
     ur_ = other.ur_;
     other.ur_ = rtmp;
+
+    id_.swap(other.id_);
+    plev_.swap(other.plev_);
+    m_.swap(other.m_);
     }
 
 template <class IndexT>
@@ -526,6 +644,7 @@ read(std::istream& s)
     for(int j = 0; j < r_; ++j) 
         {
         index_[j].read(s);
+        setKey(j);
         ur_ += index_[j].uniqueReal();
         }
     }
@@ -590,11 +709,8 @@ template<class IndexT>
 Arrow
 dir(const IndexSet<IndexT>& is, const IndexT& I)
     {
-    for(int j = 0; j < is.r(); ++j)
-        {
-        if(is[j] == I) 
-            return is[j].dir();
-        }
+    const int j = is.find(I);
+    if(j >= 0) return is[j].dir();
     Error("dir: Index not found");
     return In;
     }
@@ -619,11 +735,8 @@ template <class IndexT>
 int
 findindex(const IndexSet<IndexT>& iset, const IndexT& I)
     {
-    int j = (I.m()==1 ? iset.rn() : 0);
-    for(; j < iset.r(); ++j)
-        {
-        if(iset[j] == I) return j;
-        }
+    const int j = iset.find(I);
+    if(j >= 0) return j;
     Print(I);
     Error("Index I not found");
     return 0;
@@ -674,16 +787,43 @@ getperm(const IndexSet<IndexT>& iset,
 	    }
 	}
 
+//
+// Compute the permutation P taking iset to oset,
+// where oset is another IndexSet
+//
+template <class IndexT>
+void
+getperm(const IndexSet<IndexT>& iset, 
+        const IndexSet<IndexT>& oset, 
+        Permutation& P)
+	{
+	for(int j = 1; j <= iset.r(); ++j)
+	    {
+	    bool got_one = false;
+	    for(int k = 1; k <= iset.r(); ++k)
+            {
+            if(oset.same(j,iset,k))
+                { 
+                P.fromTo(j,k); 
+                got_one = true; 
+                break;
+                }
+            }
+	    if(!got_one)
+            {
+            Cout << "j = " << j << "\n";
+            Print(iset); 
+            Print(oset); 
+            Error("IndexSet::getperm: no matching index");
+            }
+	    }
+	}
+
 template <class IndexT>
 bool
 hasindex(const IndexSet<IndexT>& iset, const IndexT& I)
 	{
-    int j = (I.m()==1 ? iset.rn() : 0);
-    for(; j < iset.r(); ++j)
-        {
-        if(iset[j] == I) return true;
-        }
-    return false;
+    return (iset.find(I) >= 0);
 	}
 
 template <class IndexT>
@@ -87,6 +87,7 @@ init(string rname, IndexType type,
         }
 
     //Construct individual Combiners
+    combs.clear();
     QCounter c(left_);
     IQIndex::Storage iq;
     for( ; c.notDone(); ++c)
@@ -103,34 +104,74 @@ init(string rname, IndexType type,
 
         iq.push_back(IndexQN(co.right(),q));
         }
+
+    sector_.resize(combs.size());
+    offset_.assign(combs.size(),0);
+
     if(do_condense) 
         {
-        ucright_ = IQIndex(rname,iq,rdir,primelevel);
-        string cname = "cond::" + rname;
-        cond = Condenser(ucright_,cname);
-        right_ = cond.smallind();
+        //Merge the blocks having the same QN into
+        //a single Index ("sector") of right_
+        map<QN,int> totm;
+        Foreach(const IndexQN& x, iq) totm[x.qn] += x.m();
+
+        IQIndex::Storage ciq;
+        map<QN,Index> qsector;
+        map<QN,int> qoffset;
+        for(map<QN,int>::const_iterator it = totm.begin(); it != totm.end(); ++it)
+            {
+            qsector[it->first] = Index("condensed",it->second,type,primelevel);
+            ciq.push_back(IndexQN(qsector[it->first],it->first));
+            }
+        for(size_t k = 0; k < iq.size(); ++k)
+            {
+            const QN& q = iq[k].qn;
+            sector_[k] = qsector[q];
+            offset_[k] = qoffset[q];
+            qoffset[q] += iq[k].m();
+            }
+        right_ = IQIndex("cond::"+rname,ciq,rdir,primelevel);
         }
     else 
         {
+        for(size_t k = 0; k < combs.size(); ++k)
+            sector_[k] = combs[k].right();
         right_ = IQIndex(rname,iq,rdir,primelevel);
         }
     initted = true;
+
+    initMaps();
 	}
 
+void IQCombiner::
+initMaps() const
+    {
+    combmap_.clear();
+    rightmap_.clear();
+    for(size_t k = 0; k < combs.size(); ++k)
+        {
+        combmap_[combs[k].uniqueReal()] = k;
+        rightmap_[sector_[k]].push_back(k);
+        }
+    }
+
 IQCombiner::
 operator IQTensor() const
     {
     if(!initted) Error("IQCombiner::operator IQTensor(): IQCombiner not initialized.");
 
     vector<IQIndex> iqinds(left_);
-    iqinds.push_back((do_condense ? ucright_ : right_));
+    iqinds.push_back(right_);
     IQTensor res(iqinds);
 
-    Foreach(const Combiner& co, combs)
+    for(size_t k = 0; k < combs.size(); ++k)
         {
         //Here we are using the fact that Combiners
         //can be converted to ITensors
-        res.insert(co);
+        ITensor block(combs[k]);
+        if(sector_[k] != combs[k].right())
+            block.expandIndex(combs[k].right(),sector_[k],offset_[k]);
+        res += block;
         }
 
 #ifdef DEBUG
@@ -144,12 +185,6 @@ operator IQTensor() const
         }
 #endif
 
-    if(do_condense) 
-        { 
-        IQTensor rcopy(res); 
-        cond.product(rcopy,res); 
-        }
-
     return res;
     }
 
@@ -171,11 +206,9 @@ prime(IndexType type, int inc)
     if(initted)
         {
         right_.prime(type,inc);
-        if(do_condense) 
-            {
-            cond.prime(type,inc);
-            ucright_.prime(type,inc);
-            }
+        Foreach(Index& S, sector_)
+            S.prime(type,inc);
+        initMaps();
         }
     }
 
@@ -193,11 +226,6 @@ conj()
     { 
     init();
     Foreach(IQIndex& I, left_) I.conj(); 
-    if(do_condense) 
-        {
-        cond.conj();
-        ucright_.conj();
-        }
     right_.conj();
     }
 
@@ -212,28 +240,20 @@ product(IQTensor T, IQTensor& res) const
         //
         //T has right IQIndex, expand it
         //
-        IQTensor T_uncondensed;
-        if(do_condense) 
-            { 
-            cond.product(T,T_uncondensed); 
-            }
-        const IQTensor& T_ = (do_condense ? T_uncondensed : T);
-        const IQIndex& r = (do_condense ? ucright_ : right_);
-
         if(Global::checkArrows())
-            if(dir(T_.indices(),r) == r.dir())
+            if(dir(T.indices(),right_) == right_.dir())
                 {
-                cout << "IQTensor = " << T_ << endl;
+                cout << "IQTensor = " << T << endl;
                 cout << "IQCombiner = " << *this << endl;
-                cout << "(Right) IQIndex from IQCombiner = " << r << endl;
+                cout << "(Right) IQIndex from IQCombiner = " << right_ << endl;
                 Error("Incompatible arrow directions in operator*(IQTensor,IQCombiner).");
                 }
 
-        iqinds.reserve(T_.indices().r()-1+left_.size());
+        iqinds.reserve(T.indices().r()-1+left_.size());
 
-        Foreach(const IQIndex& I, T_.indices())
+        Foreach(const IQIndex& I, T.indices())
             {
-            if(I == r)
+            if(I == right_)
                 copy(left_.begin(),left_.end(),back_inserter(iqinds));
             else
                 iqinds.push_back(I);
@@ -241,21 +261,27 @@ product(IQTensor T, IQTensor& res) const
 
         res = IQTensor(iqinds);
 
-        map<Index, const Combiner*> rightcomb;
-        Foreach(const Combiner& co, combs)
-            {
-            rightcomb[co.right()] = &co;
-            }
-
-        Foreach(const ITensor& tt, T_.blocks())
+        //Each sector of right_ holds the blocks of one 
+        //or more Combiners: cut out each block and 
+        //uncombine it
+        Foreach(const ITensor& tt, T.blocks())
         Foreach(const Index& K, tt.indices())
             {
-            if(hasindex(r,K))
-                { 
-                res += (*(rightcomb[K]) * tt); 
-                break;
+            if(!hasindex(right_,K)) continue;
+
+            map<Index,vector<int> >::const_iterator rit = rightmap_.find(K);
+            if(rit == rightmap_.end())
+                {
+                Print(K);
+                Error("IQCombiner::product: no Combiner for Index");
+                }
+            Foreach(int k, rit->second)
+                {
+                const Combiner& co = combs[k];
+                res += co * tt.slab(K,co.right(),offset_[k]);
                 }
-            } //end for
+            break;
+            }
 
         }
     else
@@ -272,8 +298,7 @@ product(IQTensor T, IQTensor& res) const
             if(!hasindex(*this,I)) iqinds.push_back(I); 
             }
         //and res will have c's right IQIndex
-        if(do_condense) iqinds.push_back(ucright_);
-        else            iqinds.push_back(right_);
+        iqinds.push_back(right_);
 
         res = IQTensor(iqinds);
 
@@ -305,12 +330,10 @@ product(IQTensor T, IQTensor& res) const
                 }
             }
 
-        //Create map of Combiners using uniqueReal as key
-        map<ApproxReal, const Combiner*> combmap;
-        Foreach(const Combiner& co, combs)
-            {
-            combmap[co.uniqueReal()] = &co;
-            }
+        //Blocks of res made of the blocks of 
+        //several Combiners (when condensing),
+        //keyed by their uniqueReal
+        map<ApproxReal,ITensor> shared;
 
         //Loop over each block in T and apply appropriate
         //Combiner (determined by the uniqueReal of the 
@@ -324,33 +347,48 @@ product(IQTensor T, IQTensor& res) const
                     block_ur += K.uniqueReal();
                 }
 
-            if(combmap.count(block_ur) == 0)
+            map<ApproxReal,int>::const_iterator cit = combmap_.find(block_ur);
+            if(cit == combmap_.end())
                 {
                 Print(t);
                 cout << "\nleft indices \n";
                 for(size_t j = 0; j < left_.size(); ++j)
                     { cout << j << " " << left_[j] << "\n"; }
                 cout << "\n" << endl;
-
-                typedef map<ApproxReal, const Combiner*>::const_iterator
-                combmap_const_it;
-                for(combmap_const_it uu = combmap.begin();
-                    uu != combmap.end(); ++uu)
-                    {
-                    cout << "Combiner: " << endl;
-                    cout << *(uu->second) << endl;
-                    }
+                cout << *this << endl;
                 Error("no combmap entry for block_ur in IQCombiner prod");
                 }
+            const int k = cit->second;
+            const Combiner& co = combs[k];
+            const Index& S = sector_[k];
+
+            //A block making up a whole sector is combined
+            //straight into the sector Index
+            const bool whole = (S.m() == co.right().m());
+            ITensor ct;
+            co.combine(t,(whole ? S : co.right()),ct);
 
-            res += (*combmap[block_ur] * t);
+            if(whole)
+                {
+                res.insert(ct);
+                continue;
+                }
+
+            //Copy block into its sector
+            IndexSet<Index> dinds;
+            Foreach(const Index& I, ct.indices())
+                dinds.addindex(I == co.right() ? S : I);
+            ITensor& dest = shared[dinds.uniqueReal()];
+            if(dest.isNull()) dest = ITensor(dinds);
+            dest.insertSlab(ct,co.right(),S,offset_[k]);
             }
 
-        if(do_condense) 
-            { 
-            IQTensor rcopy(res); 
-            cond.product(rcopy,res); 
+        for(map<ApproxReal,ITensor>::const_iterator it = shared.begin();
+            it != shared.end(); ++it)
+            {
+            res.insert(it->second);
             }
+
         }
     } //void product(const IQTensor& T, IQTensor& res) const
 
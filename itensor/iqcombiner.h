@@ -102,13 +102,27 @@ class IQCombiner
     mutable std::vector<Combiner> combs;
     mutable bool initted;
 
-    mutable Condenser cond;
-    mutable IQIndex ucright_;
     bool do_condense;
 
+    //
+    // Block maps, computed once by initMaps:
+    //   combmap_  - combined uniqueReal of left Index's -> Combiner
+    //   rightmap_ - Index of right_ -> Combiners whose blocks it holds
+    //   sector_   - Index of right_ holding the block of each Combiner
+    //   offset_   - offset of that block within its sector_ Index
+    // (Without condensing, sector_[k] is just combs[k].right().)
+    //
+    mutable std::map<ApproxReal,int> combmap_;
+    mutable std::map<Index,std::vector<int> > rightmap_;
+    mutable std::vector<Index> sector_;
+    mutable std::vector<int> offset_;
+
     //
     /////////////
 
+    void
+    initMaps() const;
+
     typedef std::map<ApproxReal, Combiner>::iterator
     setcomb_it;
 
@@ -30,6 +30,7 @@ solo()
 	if(!p.unique())
         {
         p = make_shared<IQTDat>(*p);
+        DO_IF_PS(Prodstats::countCopy(Prodstats::stats().iqt_copies);)
         }
 	}
 
@@ -1045,8 +1046,7 @@ operator*=(const IQTensor& other)
     if(hasindex(*this,IQIndex::IndReIm()) && hasindex(other,IQIndex::IndReIm()) && !hasindex(other,IQIndex::IndReImP())
 	    && !hasindex(other,IQIndex::IndReImPP()) && !hasindex(*this,IQIndex::IndReImP()) && !hasindex(*this,IQIndex::IndReImPP()))
         {
-        this->prime(ReIm);
-        operator*=(ComplexProd() * primed(other,ReIm,2));
+        complexProduct(*this,other);
         return *this;
         }
 
@@ -1107,7 +1107,7 @@ operator*=(const IQTensor& other)
                     {
                     cout << riqind_holder[n] << endl;
                     }
-                Error("Too many indices (>= 8) on resulting IQTensor");
+                Error("Too many indices (>= NMAX) on resulting IQTensor");
                 }
 #endif
             riqind_holder[rholder] = I;
@@ -1177,6 +1177,156 @@ operator*=(const IQTensor& other)
 
     } //IQTensor& IQTensor::operator*=(const IQTensor& other)
 
+IQTFloat::
+IQTFloat()
+    { }
+
+IQTFloat::
+IQTFloat(const IQTensor& T)
+    { 
+    if(T.isNull()) return;
+    is_ = make_shared<IndexSet<IQIndex> >(T.indices());
+    blocks_.reserve(T.iten_size());
+    Foreach(const ITensor& t, T.blocks())
+        blocks_.push_back(ITFloat(t));
+    }
+
+IQTensor IQTFloat::
+toTensor() const
+    {
+    if(isNull()) return IQTensor();
+
+    vector<IQIndex> iqinds(is_->begin(),is_->end());
+    IQTensor res(iqinds);
+    Foreach(const ITFloat& b, blocks_)
+        {
+        res.insert(b.toTensor());
+        }
+    return res;
+    }
+
+IQTFloat& IQTFloat::
+operator*=(const IQTFloat& other)
+    {
+    if(isNull() || other.isNull())
+        Error("Null IQTFloat in product");
+
+    //Complex products are done in double precision
+    //(see IQTensor::operator*=)
+    if(hasindex(*is_,IQIndex::IndReIm()) && hasindex(*other.is_,IQIndex::IndReIm()))
+        {
+        *this = IQTFloat(toTensor() * other.toTensor());
+        return *this;
+        }
+
+    //As in IQTensor::operator*=, find the uncontracted
+    //IQIndex's and the Index's (and IQIndex's) 
+    //being contracted
+    set<ApproxReal> common_inds;
+    array<IQIndex,NMAX> riqind_holder;
+    int rholder = 0;
+    Foreach(const IQIndex& I, indices())
+        {
+        if(hasindex(*other.is_,I))
+            {
+            Foreach(const Index& i, I.indices())
+                common_inds.insert(ApproxReal(i.uniqueReal()));
+            common_inds.insert(ApproxReal(I.uniqueReal()));
+            }
+        else
+            {
+            riqind_holder[rholder] = I;
+            ++rholder;
+            }
+        }
+    Foreach(const IQIndex& I, other.indices())
+        {
+        if(!common_inds.count(ApproxReal(I.uniqueReal())))
+            {
+            riqind_holder[rholder] = I;
+            ++rholder;
+            }
+        }
+
+    //Blocks having the same set of contracted
+    //Index's are multiplied together
+    multimap<ApproxReal,const ITFloat*> com_other;
+    Foreach(const ITFloat& t, other.blocks_)
+        {
+        Real r = 0.0;
+        Foreach(const Index& I, t.indices())
+            {
+            if(common_inds.count(ApproxReal(I.uniqueReal())))
+                { r += I.uniqueReal(); }
+            }
+        com_other.insert(make_pair(ApproxReal(r),&t));
+        }
+
+    typedef multimap<ApproxReal,const ITFloat*>::const_iterator
+    mit;
+    vector<pair<const ITFloat*,const ITFloat*> > pairs;
+    Foreach(const ITFloat& t, blocks_)
+        {
+        Real r = 0.0;
+        Foreach(const Index& I, t.indices())
+            {
+            if(common_inds.count(ApproxReal(I.uniqueReal())))
+                { r += I.uniqueReal(); }
+            }
+        pair<mit,mit> rrange = com_other.equal_range(ApproxReal(r));
+        for(mit rr = rrange.first; rr != rrange.second; ++rr)
+            {
+            pairs.push_back(make_pair(&t,rr->second));
+            }
+        }
+
+    //The block products are independent
+    vector<ITFloat> prods(pairs.size());
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for(int n = 0; n < int(pairs.size()); ++n)
+        {
+        prods[n] = *(pairs[n].first);
+        prods[n] *= *(pairs[n].second);
+        }
+
+    //Products belonging to the same block of 
+    //the result are added together
+    vector<ITFloat> nblocks;
+    nblocks.reserve(prods.size());
+    map<ApproxReal,size_t> pos;
+    Foreach(const ITFloat& t, prods)
+        {
+        if(t.scale().sign() == 0) continue;
+        const ApproxReal r(t.indices().uniqueReal());
+        map<ApproxReal,size_t>::const_iterator p = pos.find(r);
+        if(p == pos.end())
+            {
+            pos[r] = nblocks.size();
+            nblocks.push_back(t);
+            }
+        else
+            {
+            nblocks[p->second] += t;
+            }
+        }
+
+    is_ = make_shared<IndexSet<IQIndex> >(riqind_holder,rholder,0);
+    blocks_.swap(nblocks);
+
+    return *this;
+    }
+
+void IQTFloat::
+product(const IQTensor& A, IQTensor& res) const
+    {
+    if(isNull()) Error("IQTFloat is null");
+    IQTFloat Af(A);
+    Af *= *this;
+    res = Af.toTensor();
+    }
+
 IQTensor& IQTensor::
 operator/=(const IQTensor& other)
     {
@@ -1486,6 +1636,63 @@ BraKet(IQTensor x, const IQTensor& y, Real& re, Real& im)
     x.toComplex(re,im);
     }
 
+void
+linearComb(const std::vector<IQTensor>& T, const VectorRef& c, IQTensor& res)
+    {
+    const int n = c.Length();
+    if(n == 0 || n > int(T.size())) 
+        Error("linearComb: number of coefficients must be in [1,T.size()]");
+
+    const IQTensor& T0 = T.front();
+    bool mixed = false;
+    for(int k = 1; k < n; ++k)
+        {
+        if(isComplex(T[k]) != isComplex(T0)) mixed = true;
+        }
+    if(mixed)
+        {
+        IQTensor r = c(1)*T0;
+        for(int k = 1; k < n; ++k) r += c(k+1)*T[k];
+        res.swap(r);
+        return;
+        }
+
+    //Gather the blocks of each sector along with
+    //the coefficients of the IQTensors they come from
+    typedef map<ApproxReal,pair<vector<ITensor>,vector<Real> > >
+    BlockMap;
+    BlockMap bm;
+    for(int k = 0; k < n; ++k)
+        {
+        if(fabs(T[k].uniqueReal()-T0.uniqueReal()) > 1.0e-11) 
+            {
+            Print(T0.indices());
+            Print(T[k].indices());
+            Error("linearComb: mismatched indices");
+            }
+        Foreach(const ITensor& t, T[k].blocks())
+            {
+            pair<vector<ITensor>,vector<Real> >& b = bm[ApproxReal(t.uniqueReal())];
+            b.first.push_back(t);
+            b.second.push_back(c(k+1));
+            }
+        }
+
+    vector<IQIndex> iqinds;
+    Foreach(const IQIndex& I, T0.indices()) iqinds.push_back(I);
+    IQTensor r(iqinds);
+    for(BlockMap::const_iterator it = bm.begin(); it != bm.end(); ++it)
+        {
+        const vector<Real>& cb = it->second.second;
+        Vector cv(cb.size());
+        for(size_t j = 0; j < cb.size(); ++j) cv(j+1) = cb[j];
+        ITensor t;
+        linearComb(it->second.first,cv,t);
+        r.insert(t);
+        }
+    res.swap(r);
+    }
+
 
 QN
 div(const IQTensor& T)
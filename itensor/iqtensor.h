@@ -11,6 +11,7 @@
 class IQTDat;
 class IQCombiner;
 class IQTSparse;
+class IQTFloat;
 
 typedef boost::shared_ptr<IQTDat>
 IQTDatPtr;
@@ -153,7 +154,7 @@ class IQTensor
     //
     IQTensor 
     operator*(IQTensor other) const 
-        { other *= *this; return other; }
+        { other *= *this; return takeData(other); }
 
     IQTensor& 
     operator*=(const IQTensor& other);
@@ -163,7 +164,7 @@ class IQTensor
     //
     IQTensor 
     operator/(IQTensor other) const 
-        { other /= *this; return other; }
+        { other /= *this; return takeData(other); }
 
     IQTensor& 
     operator/=(const IQTensor& other);
@@ -174,9 +175,12 @@ class IQTensor
     IQTensor& 
     operator+=(const IQTensor& o);
 
-    IQTensor 
-    operator+(const IQTensor& o) const 
-        { IQTensor res(*this); res += o; return res; }
+    //The operators below take their IQTensor argument by
+    //value so that a temporary is modified in place instead
+    //of having its blocks copied (see takeData in itensor.h)
+    friend inline IQTensor 
+    operator+(IQTensor A, const IQTensor& B)
+        { A += B; return takeData(A); }
 
     IQTensor&
     operator-=(const IQTensor& o)
@@ -187,9 +191,9 @@ class IQTensor
         return operator+=(oth);
         }
 
-    IQTensor 
-    operator-(const IQTensor& o) const 
-        { IQTensor res(*this); res -= o; return res; }
+    friend inline IQTensor 
+    operator-(IQTensor A, const IQTensor& B)
+        { A -= B; return takeData(A); }
 
     //
     // Multiplication by a scalar
@@ -197,24 +201,24 @@ class IQTensor
     IQTensor& 
     operator*=(Real fac);
 
-    IQTensor 
-    operator*(Real fac) const
-        { IQTensor res(*this); res *= fac; return res; }
+    friend inline IQTensor 
+    operator*(IQTensor T, Real fac)
+        { T *= fac; return takeData(T); }
 
     friend inline IQTensor 
     operator*(Real fac, IQTensor T) 
-        { T *= fac; return T; }
+        { T *= fac; return takeData(T); }
 
     IQTensor& 
     operator/=(Real fac);
 
-    IQTensor 
-    operator/(Real fac) const 
-        { IQTensor res(*this); res /= fac; return res; }
+    friend inline IQTensor 
+    operator/(IQTensor T, Real fac)
+        { T /= fac; return takeData(T); }
 
     friend inline IQTensor 
     operator/(Real fac, IQTensor t) 
-        { return (t /= fac); }
+        { t /= fac; return takeData(t); }
 
     IQTensor
     operator-() const { IQTensor T(*this); T *= -1; return T; }
@@ -222,13 +226,13 @@ class IQTensor
     IQTensor& 
     operator*=(const LogNumber& lgnum);
 
-    IQTensor 
-    operator*(const LogNumber& lgnum) const
-        { IQTensor res(*this); res *= lgnum; return res; }
+    friend inline IQTensor 
+    operator*(IQTensor T, const LogNumber& lgnum)
+        { T *= lgnum; return takeData(T); }
 
     friend inline IQTensor 
     operator*(const LogNumber& lgnum, IQTensor T) 
-        { T *= lgnum; return T; }
+        { T *= lgnum; return takeData(T); }
 
     //
     // Contracting product with an ITensor
@@ -245,9 +249,9 @@ class IQTensor
     operator*=(const IQIndexVal& iv)
         { (*this) *= IQTensor(iv); return *this; }
 
-    IQTensor 
-    operator*(const IQIndexVal& iv) const
-        { IQTensor res(*this); res *= iv; return res; }
+    friend inline IQTensor 
+    operator*(IQTensor T, const IQIndexVal& iv)
+        { T *= iv; return takeData(T); }
 
     friend inline IQTensor 
     operator*(const IQIndexVal& iv, const IQTensor& T) 
@@ -431,6 +435,9 @@ class IQTensor
     typedef IQTSparse
     SparseT;
 
+    typedef IQTFloat
+    FloatT;
+
     friend class IQTSparse;
 
     friend void 
@@ -532,6 +539,61 @@ const IQTensor&
 IQComplex_i() { return IQTensor::Complex_i(); }
 
 
+//
+// IQTFloat
+//
+// Single-precision copy of an IQTensor, holding an 
+// ITFloat for each block (see ITFloat in itensor.h)
+//
+class IQTFloat
+    {
+    public:
+
+    typedef IQTensor
+    TensorT;
+
+    IQTFloat();
+
+    explicit
+    IQTFloat(const IQTensor& T);
+
+    bool
+    isNull() const { return !is_; }
+
+    const IndexSet<IQIndex>&
+    indices() const { return *is_; }
+
+    const std::vector<ITFloat>&
+    blocks() const { return blocks_; }
+
+    //Converts back to double precision
+    IQTensor
+    toTensor() const;
+
+    //Contracting product; the products of
+    //the blocks are done in parallel
+    //when compiled with OpenMP
+    IQTFloat&
+    operator*=(const IQTFloat& other);
+
+    IQTFloat
+    operator*(const IQTFloat& other) const 
+        { IQTFloat res(*this); res *= other; return res; }
+
+    //Computes res = A * T in single precision,
+    //converting A and the result once
+    //(res may be the same object as A)
+    void
+    product(const IQTensor& A, IQTensor& res) const;
+
+    private:
+
+    IndexSet<IQIndex>::Ptr is_;
+    std::vector<ITFloat> blocks_;
+
+    };
+
+
 class IQTDat : public boost::noncopyable
     {
     public:
@@ -711,6 +773,15 @@ Dot(IQTensor x, const IQTensor& y);
 void 
 BraKet(IQTensor x, const IQTensor& y, Real& re, Real& im);
 
+//
+// Sets res to the linear combination
+// c(1)*T[0] + ... + c(n)*T[n-1], n = c.Length(),
+// combining the matching blocks of the T[k]
+// with linearComb for ITensors
+//
+void
+linearComb(const std::vector<IQTensor>& T, const VectorRef& c, IQTensor& res);
+
 //Compute divergence of IQTensor T
 //
 //If DEBUG defined and all blocks do not have
@@ -428,6 +428,13 @@ scaleTo(const LogNumber& newscale) const
 	}
 
 
+void IQTSparse::
+swap(IQTSparse& other)
+    {
+    is_.swap(other.is_);
+    d_.swap(other.d_);
+    }
+
 void IQTSparse::
 read(std::istream& s)
     {
@@ -506,8 +513,8 @@ product(const IQTSparse& S, const IQTensor& T, IQTensor& res)
     set<ApproxReal> common_inds;
     
     //Load iqindex_ with those IQIndex's *not* common to *this and other
-    static vector<IQIndex> riqind_holder;
-    riqind_holder.resize(0);
+    vector<IQIndex> riqind_holder;
+    riqind_holder.reserve(S.is_->r()+T.is_->r());
 
     for(int i = 1; i <= S.is_->r(); ++i)
         {
@@ -191,6 +191,9 @@ class IQTSparse
     void 
     scaleTo(const LogNumber& newscale) const;
 
+    void
+    swap(IQTSparse& other);
+
     void
     read(std::istream& s);
 
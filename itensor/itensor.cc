@@ -127,7 +127,7 @@ ITensor(const Index& i1, const Index& i2, const Index& i3,
 #endif
 	array<Index,NMAX> ii = {{ i1, i2, i3, i4, i5, i6, i7, i8 }};
 	int size = 3;
-	while(ii[size] != Index::Null()) ++size;
+	while(size < 8 && ii[size] != Index::Null()) ++size;
 	int alloc_size = -1; 
     is_ = IndexSet<Index>(ii,size,alloc_size,0);
 	allocate(alloc_size);
@@ -174,16 +174,16 @@ ITensor(const IndexVal& iv1, const IndexVal& iv2,
     //Assign specified element to 1
     array<int,NMAX+1> iv = 
         {{ iv1.i, iv2.i, iv3.i, iv4.i, iv5.i, iv6.i, iv7.i, iv8.i, 1 }};
-    array<int,NMAX> ja; 
+    array<int,NMAX+1> ja; 
     ja.assign(0);
     for(int k = 0; k < is_.rn(); ++k) //loop over indices of this ITensor
     for(int j = 0; j < size; ++j)      // loop over the given indices
         {
         if(is_[k] == ii[j]) 
-            { ja[k] = iv[j]-1; break; }
+            { ja[k+1] = iv[j]-1; break; }
         }
 
-    p->v[_ind(is_,ja[0],ja[1],ja[2],ja[3],ja[4],ja[5],ja[6],ja[7])] = 1;
+    p->v[_ind(is_,ja)] = 1;
     }
 
 ITensor::
@@ -542,8 +542,38 @@ groupIndices(const array<Index,NMAX+1>& indices, int nind,
     if(tot_m != grouped.m()) Error("ITensor::groupAndReplace: \
                                     mismatched index sizes.");
 
+    //If the m != 1 indices being grouped are adjacent
+    //in storage and in the same order as in indices,
+    //grouping them is only a relabeling: res can share
+    //the data of this ITensor with no copying
+    int first = 1;
+    while(first <= is_.rn() && isReplaced[first] <= 0) ++first;
+    bool adjacent = (first+nn-1 <= is_.rn());
+    for(int j = 1; adjacent && j <= nn; ++j)
+        adjacent = (isReplaced[first+j-1] == j);
+
+    if(nn == 0 || adjacent)
+        {
+        IndexSet<Index> nindices; 
+        for(int j = 1; j <= is_.rn(); ++j)
+            {
+            if(isReplaced[j] == 0) 
+                nindices.addindex(is_.index(j));
+            else 
+            if(isReplaced[j] == 1) 
+                nindices.addindex(grouped);
+            }
+        if(nn == 0) nindices.addindex(grouped);
+        for(int j = is_.rn()+1; j <= r(); ++j) 
+            if(isReplaced[j] == 0) nindices.addindex(is_.index(j));
+
+        res = ITensor(nindices,*this);
+        DO_IF_PS(++Prodstats::stats().combine_reshape;)
+        return;
+        }
+
     //Compute rn_ of res
-    const int res_rn_ = is_.rn() - nn + (nn == 0 ? 0 : 1);
+    const int res_rn_ = is_.rn() - nn + 1;
 
     IndexSet<Index> nindices; 
     Permutation P;
@@ -569,10 +599,8 @@ groupIndices(const array<Index,NMAX+1>& indices, int nind,
     for(int j = is_.rn()+1; j <= r(); ++j) 
         if(isReplaced[j] == 0) nindices.addindex(is_.index(j));
 
-    if(nn == 0) 
-        res = ITensor(nindices,*this);
-    else        
-        res = ITensor(nindices,*this,P); 
+    res = ITensor(nindices,*this,P); 
+    DO_IF_PS(++Prodstats::stats().combine_copy;)
     }
 
 void ITensor::
@@ -662,10 +690,7 @@ tieIndices(const array<Index,NMAX>& indices, int nind,
     for(; nc.notDone(); ++nc)
         {
         resdat[nc.ind] =
-        thisdat[_ind(is_,*ii[1],*ii[2],
-                         *ii[3],*ii[4],
-                         *ii[5],*ii[6],
-                         *ii[7],*ii[8])];
+        thisdat[_ind(is_,ii)];
         }
 
     is_.swap(new_is_);
@@ -815,10 +840,7 @@ trace(const array<Index,NMAX>& indices, int nind)
         for(trace_ind = 0; trace_ind < tm; ++trace_ind)
             {
             newval += 
-            thisdat[_ind(is_,*ii[1],*ii[2],
-                             *ii[3],*ii[4],
-                             *ii[5],*ii[6],
-                             *ii[7],*ii[8])];
+            thisdat[_ind(is_,ii)];
             }
         resdat[nc.ind] = newval;
         }
@@ -897,11 +919,12 @@ expandIndex(const Index& small, const Index& big, int start)
     //Comparing nmax and omax determines whether
     //old dat fits into new dat sequentially, in which
     //case we can use std::copy
+    array<int,NMAX+1> last;
+    last.assign(0);
+    for(int j = 1; j <= is_.r(); ++j)
+        last[j] = is_.m(j)-1;
     const
-	int nmax = 1+_ind(newinds,is_[0].m()-1,is_[1].m()-1, 
-                              is_[2].m()-1,is_[3].m()-1, 
-                              is_[4].m()-1,is_[5].m()-1, 
-                              is_[6].m()-1,is_[7].m()-1);
+	int nmax = 1+_ind(newinds,last);
 
     const
     int omax = oldp->v.Length();
@@ -915,10 +938,7 @@ expandIndex(const Index& small, const Index& big, int start)
         Counter c(is_);
         for(; c.notDone(); ++c)
             {
-            newdat[inc+_ind(newinds,c.i[1],c.i[2],
-                                    c.i[3],c.i[4],
-                                    c.i[5],c.i[6],
-                                    c.i[7],c.i[8])]
+            newdat[inc+_ind(newinds,c.i)]
             = olddat[c.ind];
             }
         }
@@ -926,6 +946,137 @@ expandIndex(const Index& small, const Index& big, int start)
     is_.swap(newinds);
     }
 
+//
+// For each Index of the slab index set sis, computes the stride
+// of the corresponding Index of bis (with big in place of small)
+// as well as the offset of the first element of the slab
+//
+static void
+slabStrides(const IndexSet<Index>& bis, const IndexSet<Index>& sis,
+            const Index& small, const Index& big, int start,
+            array<int,NMAX+1>& str, int& off)
+    {
+    if(bis.r() != sis.r())
+        {
+        Print(bis);
+        Print(sis);
+        Error("slab: mismatched index sets");
+        }
+
+    array<int,NMAX+1> bstr;
+    bstr[0] = 1;
+    for(int k = 1; k < bis.r(); ++k)
+        bstr[k] = bstr[k-1]*bis[k-1].m();
+
+    off = -1;
+    for(int j = 1; j <= sis.r(); ++j)
+        {
+        const Index& J = (sis.index(j) == small ? big : sis.index(j));
+        const int k = findindex(bis,J);
+        str[j] = bstr[k];
+        if(J == big) off = start*bstr[k];
+        }
+    if(off < 0)
+        {
+        Print(sis);
+        Print(small);
+        Error("slab: couldn't find index");
+        }
+    }
+
+//
+// Copies between the elements of a slab with index set sis
+// (data sdat) and the bigger tensor it is part of (data bdat),
+// using the strides and offset from slabStrides. Leading 
+// indices of sis which are also contiguous in the bigger 
+// tensor are copied as one run.
+//
+static void
+copySlab(const IndexSet<Index>& sis, const array<int,NMAX+1>& str, int off,
+         const Real* from, Real* to, Real fac, bool to_big)
+    {
+    const int rn = sis.rn();
+    int run = 1,
+        q = 1;
+    while(q <= rn && str[q] == run) 
+        {
+        run *= sis.m(q);
+        ++q;
+        }
+    //Otherwise run over the first index at its stride
+    int bstep = 1;
+    if(q == 1 && rn > 0)
+        {
+        run = sis.m(1);
+        bstep = str[1];
+        q = 2;
+        }
+
+    array<int,NMAX+1> i;
+    for(int j = q; j <= rn; ++j) i[j] = 0;
+
+    const int len = sis.dim();
+    int boff = off;
+    for(int s = 0; s < len; s += run)
+        {
+        if(to_big)
+            {
+            const Real* f = from + s;
+            Real* t = to + boff;
+            for(int n = 0; n < run; ++n) t[n*bstep] = fac*f[n];
+            }
+        else
+            {
+            const Real* f = from + boff;
+            Real* t = to + s;
+            for(int n = 0; n < run; ++n) t[n] = fac*f[n*bstep];
+            }
+
+        for(int j = q; j <= rn; ++j)
+            {
+            boff += str[j];
+            if(++i[j] < sis.m(j)) break;
+            boff -= str[j]*sis.m(j);
+            i[j] = 0;
+            }
+        }
+    }
+
+void ITensor::
+insertSlab(const ITensor& t, const Index& small, 
+           const Index& big, int start)
+    {
+    array<int,NMAX+1> str;
+    int off = 0;
+    slabStrides(is_,t.is_,small,big,start,str,off);
+
+    solo();
+    scaleTo(1);
+
+    copySlab(t.is_,str,off,t.p->v.Store(),p->v.Store(),t.scale_.real0(),true);
+    }
+
+ITensor ITensor::
+slab(const Index& big, const Index& small, int start) const
+    {
+    IndexSet<Index> sis;
+    for(int k = 1; k <= r(); ++k)
+        sis.addindex(is_.index(k) == big ? small : is_.index(k));
+
+    //Same size: only a relabeling, so share the data
+    if(small.m() == big.m()) return ITensor(sis,*this);
+
+    ITensor res(sis);
+    res.scale_ = scale_;
+
+    array<int,NMAX+1> str;
+    int off = 0;
+    slabStrides(is_,res.is_,small,big,start,str,off);
+
+    copySlab(res.is_,str,off,p->v.Store(),res.p->v.Store(),1,false);
+    return res;
+    }
+
 int ITensor::
 vecSize() const 
     { 
@@ -1125,13 +1276,23 @@ reshapeDat(const Permutation& P, Vector& rdat) const
                 = thisdat[c.ind];
             }
         return;
-    default:
+    case 8:
         for(; c.notDone(); ++c)
             {
             rdat[(((((((*j[8])*n[7]+*j[7])*n[6]+*j[6])*n[5]+*j[5])*n[4]+*j[4])*n[3]+*j[3])*n[2]+*j[2])*n[1]+*j[1]]
                 = thisdat[c.ind];
             }
         return;
+    default:
+        //Rank < 2 or > 8 (possible if NMAX > 8)
+        for(; c.notDone(); ++c)
+            {
+            int k = 0;
+            for(int q = c.rn; q >= 1; --q)
+                k = k*n[q]+*j[q];
+            rdat[k] = thisdat[c.ind];
+            }
+        return;
     } //switch(c.rn)
 
     } // ITensor::reshapeDat
@@ -1241,6 +1402,23 @@ scaleOutNorm()
         }
     }
 
+void ITensor::
+scaleOutNormLazy()
+    {
+    //Products of data with norms in this window are 
+    //far from over- or underflow, so the data need
+    //not be rescaled (nor copied by solo)
+    const Real min_norm = 1E-30,
+               max_norm = 1E30;
+    const Real f = Norm(p->v);
+    if(f > min_norm && f < max_norm)
+        {
+        DO_IF_PS(++Prodstats::stats().norm_skip;)
+        return;
+        }
+    scaleOutNorm();
+    }
+
 void ITensor::
 scaleTo(const LogNumber& newscale)
     {
@@ -1275,6 +1453,7 @@ solo()
         VectorRef oldv(p->v);
         p = make_shared<ITDat>();
         p->v = oldv;
+        DO_IF_PS(Prodstats::countCopy(Prodstats::stats().it_copies);)
         }
 	}
 
@@ -1343,11 +1522,11 @@ _ind8(const IndexVal& iv1, const IndexVal& iv2,
     {
     array<const IndexVal*,NMAX> iv = 
         {{ &iv1, &iv2, &iv3, &iv4, &iv5, &iv6, &iv7, &iv8 }};
-    array<int,NMAX> ja; 
+    array<int,NMAX+1> ja; 
     ja.assign(0);
     //Loop over the given IndexVals
     int nn = 0;
-    for(int j = 0; j < is_.r(); ++j)
+    for(int j = 0; j < 8; ++j)
         {
         const IndexVal& J = *iv[j];
         if(J == IndexVal::Null()) break;
@@ -1358,7 +1537,7 @@ _ind8(const IndexVal& iv1, const IndexVal& iv2,
             {
             if(is_[k] == J)
                 {
-                ja[k] = J.i-1;
+                ja[k+1] = J.i-1;
                 goto next;
                 }
             }
@@ -1375,7 +1554,7 @@ _ind8(const IndexVal& iv1, const IndexVal& iv2,
         Error("Too few m > 1 indices provided");
         }
 
-    return _ind(is_,ja[0],ja[1],ja[2],ja[3],ja[4],ja[5],ja[6],ja[7]);
+    return _ind(is_,ja);
     }
 
 
@@ -1389,6 +1568,8 @@ struct ProductProps
     {
     ProductProps(const ITensor& L, const ITensor& R);
 
+    ProductProps(const IndexSet<Index>& L, const IndexSet<Index>& R);
+
     //arrays specifying which indices match
     array<bool,NMAX+1> contractedL, contractedR; 
 
@@ -1407,24 +1588,43 @@ struct ProductProps
     //contracted indices of R match order of L
     //Permutation matchL;
 
+    private:
+
+    void
+    init(const IndexSet<Index>& L, const IndexSet<Index>& R);
+
     };
 
 ProductProps::
 ProductProps(const ITensor& L, const ITensor& R) 
-    :
-    nsamen(0), 
-    cdim(1), 
-    odimL(-1), 
-    odimR(-1),
-    lcstart(100), 
-    rcstart(100)
     {
+    init(L.is_,R.is_);
+    odimL = L.p->v.Length()/cdim;
+    odimR = R.p->v.Length()/cdim;
+    }
+
+ProductProps::
+ProductProps(const IndexSet<Index>& L, const IndexSet<Index>& R) 
+    {
+    init(L,R);
+    odimL = L.dim()/cdim;
+    odimR = R.dim()/cdim;
+    }
+
+void ProductProps::
+init(const IndexSet<Index>& L, const IndexSet<Index>& R)
+    {
+    nsamen = 0; 
+    cdim = 1; 
+    lcstart = 100; 
+    rcstart = 100;
+
     for(int j = 1; j <= NMAX; ++j) 
         contractedL[j] = contractedR[j] = false;
 
-    for(int j = 1; j <= L.is_.rn(); ++j)
-	for(int k = 1; k <= R.is_.rn(); ++k)
-	    if(L.is_.index(j) == R.is_.index(k))
+    for(int j = 1; j <= L.rn(); ++j)
+	for(int k = 1; k <= R.rn(); ++k)
+	    if(L.same(j,R,k))
 		{
 		if(j < lcstart) lcstart = j;
         if(k < rcstart) rcstart = k;
@@ -1435,26 +1635,23 @@ ProductProps(const ITensor& L, const ITensor& R)
 
 		contractedL[j] = contractedR[k] = true;
 
-        cdim *= L.is_.index(j).m();
+        cdim *= L.m(j);
 
         //matchL.fromTo(k,j-lcstart+1);
 		}
     //Finish making pl
     int q = nsamen;
-    for(int j = 1; j <= L.is_.rn(); ++j)
+    for(int j = 1; j <= L.rn(); ++j)
         if(!contractedL[j]) pl.fromTo(j,++q);
     //Finish making pr and matchL
     q = nsamen;
-    for(int j = 1; j <= R.is_.rn(); ++j)
+    for(int j = 1; j <= R.rn(); ++j)
         if(!contractedR[j]) 
             {
             ++q;
             pr.fromTo(j,q);
             //matchL.fromTo(j,q);
             }
-
-    odimL = L.p->v.Length()/cdim;
-    odimR = R.p->v.Length()/cdim;
     }
 
 //Converts ITensor dats into MatrixRef's that can be multiplied as rref*lref
@@ -1552,6 +1749,296 @@ toMatrixProd(const ITensor& L, const ITensor& R, ProductProps& props,
     }
 
 
+//
+// ITFloat
+//
+
+//Copies the data "from" of a tensor with indices is into
+//"to", moving index j of is to position P.dest(j) and 
+//converting the elements to type T. The runs of the
+//first index of is are copied with a constant stride.
+template <typename F, typename T>
+void
+permuteCopy(const IndexSet<Index>& is, const Permutation& P, 
+            const F* from, T* to)
+    {
+    const int rn = is.rn();
+    if(rn == 0)
+        {
+        to[0] = from[0];
+        return;
+        }
+
+    const Permutation::int9& ind = P.ind();
+
+    //Strides of the indices of is within "to"
+    array<int,NMAX+1> n, tstride, stride, i;
+    for(int j = 1; j <= rn; ++j) n[ind[j]] = is.m(j);
+    tstride[1] = 1;
+    for(int q = 2; q <= rn; ++q) tstride[q] = tstride[q-1]*n[q-1];
+    for(int j = 1; j <= rn; ++j) 
+        {
+        stride[j] = tstride[ind[j]];
+        i[j] = 0;
+        }
+
+    const int m1 = is.m(1),
+              s1 = stride[1],
+              len = is.dim();
+    int off = 0;
+    for(int k = 0; k < len; k += m1)
+        {
+        const F* f = from + k;
+        T* t = to + off;
+        for(int q = 0; q < m1; ++q) t[q*s1] = f[q];
+
+        for(int j = 2; j <= rn; ++j)
+            {
+            off += stride[j];
+            if(++i[j] < is.m(j)) break;
+            off -= stride[j]*is.m(j);
+            i[j] = 0;
+            }
+        }
+    }
+
+//Whether the data of a tensor with contracted indices
+//marked by "contracted" (rn of them having m != 1) can 
+//be used as a matrix in a product described by props 
+//with permutation P: returns 1 if the contracted indices
+//come first and in the order given by P, -1 if they come
+//last and in order, and 0 if the data must be permuted
+int
+contractedArrangement(const array<bool,NMAX+1>& contracted,
+                      const Permutation& P, int cstart, int nsamen, int rn)
+    {
+    if(nsamen == 0) return 1;
+    for(int i = 0; i < nsamen; ++i) 
+        {
+        if(!contracted[cstart+i] || P.dest(cstart+i) != (i+1)) 
+            return 0;
+        }
+    if(contracted[1]) return 1;
+    if(contracted[rn]) return -1;
+    return 0;
+    }
+
+ITFloat::
+ITFloat()
+    { }
+
+ITFloat::
+ITFloat(const ITensor& T)
+    {
+    if(T.isNull()) return;
+
+    const Vector& v = T.p->v;
+    const Real nrm = Norm(v);
+    const Real f = (nrm == 0 ? 1 : 1./nrm);
+
+    is_ = T.is_;
+    scale_ = T.scale_;
+    if(nrm != 0) scale_ *= nrm;
+    p_ = make_shared<vector<float> >(v.Length());
+
+    vector<float>& dat = *p_;
+    const Real* pv = v.Store();
+    for(size_t n = 0; n < dat.size(); ++n) dat[n] = f*pv[n];
+    }
+
+ITensor ITFloat::
+toTensor() const
+    {
+    if(isNull()) return ITensor();
+
+    const vector<float>& dat = *p_;
+    ITensor res;
+    res.is_ = is_;
+    res.allocate(dat.size());
+    Real* pr = res.p->v.Store();
+    for(size_t n = 0; n < dat.size(); ++n) pr[n] = dat[n];
+    res.scale_ = scale_;
+    return res;
+    }
+
+ITFloat& ITFloat::
+operator*=(const ITFloat& other)
+    {
+    if(isNull() || other.isNull())
+        Error("Null ITFloat in product");
+
+    //Complex products (ReIm index on both) and the products
+    //of tensors with only m==1 indices are rare and are 
+    //done in double precision
+    if((hasindex(is_,Index::IndReIm()) && hasindex(other.is_,Index::IndReIm()))
+       || is_.rn() == 0 || other.is_.rn() == 0)
+        {
+        *this = ITFloat(toTensor() * other.toTensor());
+        return *this;
+        }
+
+    ProductProps props(is_,other.is_);
+
+    const int m = props.odimL,
+              n = props.odimR,
+              k = props.cdim;
+
+    //Use the data of either tensor as a matrix
+    //if possible, otherwise move the contracted 
+    //indices to the front
+    vector<float> ltmp, rtmp;
+
+    const float* pa = &((*p_)[0]);
+    char transa = 'T';
+    int lda = k;
+    const int larr = contractedArrangement(props.contractedL,props.pl,
+                                           props.lcstart,props.nsamen,is_.rn());
+    if(larr == -1)
+        {
+        transa = 'N';
+        lda = m;
+        }
+    else
+    if(larr == 0)
+        {
+        ltmp.resize(p_->size());
+        permuteCopy(is_,props.pl,pa,&ltmp[0]);
+        pa = &ltmp[0];
+        }
+
+    const float* pb = &((*other.p_)[0]);
+    char transb = 'N';
+    int ldb = k;
+    const int rarr = contractedArrangement(props.contractedR,props.pr,
+                                           props.rcstart,props.nsamen,other.is_.rn());
+    if(rarr == -1)
+        {
+        transb = 'T';
+        ldb = n;
+        }
+    else
+    if(rarr == 0)
+        {
+        rtmp.resize(other.p_->size());
+        permuteCopy(other.is_,props.pr,pb,&rtmp[0]);
+        pb = &rtmp[0];
+        }
+
+    //Result has the uncontracted indices 
+    //of *this first
+    shared_ptr<vector<float> > np = make_shared<vector<float> >(m*n);
+    sgemm(transa,transb,m,n,k,1,pa,lda,pb,ldb,0,&((*np)[0]),m);
+    DO_IF_PS(++Prodstats::stats().c2;)
+
+    IndexSet<Index> new_index;
+    for(int j = 0; j < is_.rn(); ++j)
+        if(!props.contractedL[j+1]) 
+            new_index.addindex(is_[j]);
+    for(int j = 0; j < other.is_.rn(); ++j)
+        if(!props.contractedR[j+1]) 
+            new_index.addindex(other.is_[j]);
+    //m==1 indices not common to both
+    for(int j = is_.rn(); j < is_.r(); ++j)
+        if(!hasindex(other.is_,is_[j]))
+            new_index.addindex(is_[j]);
+    for(int j = other.is_.rn(); j < other.is_.r(); ++j)
+        if(!hasindex(is_,other.is_[j]))
+            new_index.addindex(other.is_[j]);
+
+    is_.swap(new_index);
+    p_.swap(np);
+    scale_ *= other.scale_;
+
+    //Without this the data of a long chain of
+    //products (as in the edge tensors of an MPO)
+    //drifts into the denormal range of float
+    scaleOutNorm();
+
+    return *this;
+    }
+
+ITFloat& ITFloat::
+operator+=(const ITFloat& other)
+    {
+    if(other.isNull() || other.scale_.sign() == 0) return *this;
+    if(isNull() || scale_.sign() == 0) 
+        {
+        *this = other;
+        return *this;
+        }
+
+    if(fabs(is_.uniqueReal() - other.is_.uniqueReal()) > 1E-12)
+        {
+        Error("ITFloat::operator+=: different Index structure");
+        }
+
+    //Weights putting the data in units of the larger scale
+    Real alpha = 1,
+         beta = 1;
+    if(scale_.magnitudeLessThan(other.scale_)) 
+        {
+        alpha = (scale_/other.scale_).real();
+        scale_ = other.scale_;
+        }
+    else
+        {
+        beta = (other.scale_/scale_).real();
+        }
+
+    if(!p_.unique()) p_ = make_shared<vector<float> >(*p_);
+    vector<float>& dat = *p_;
+
+    //Bring the data of other to the index order of *this
+    const float* po = &((*other.p_)[0]);
+    vector<float> otmp;
+    Permutation P;
+    bool same_order = true;
+    for(int j = 1; j <= other.is_.rn(); ++j)
+        {
+        const int k = is_.find(other.is_.index(j))+1;
+        P.fromTo(j,k);
+        if(k != j) same_order = false;
+        }
+    if(!same_order)
+        {
+        otmp.resize(dat.size());
+        permuteCopy(other.is_,P,po,&otmp[0]);
+        po = &otmp[0];
+        }
+
+    const float a = alpha, 
+                b = beta;
+    for(size_t n = 0; n < dat.size(); ++n) 
+        dat[n] = a*dat[n] + b*po[n];
+
+    return *this;
+    }
+
+void ITFloat::
+scaleOutNorm()
+    {
+    vector<float>& dat = *p_;
+    Real nrm = 0;
+    for(size_t n = 0; n < dat.size(); ++n) 
+        nrm += Real(dat[n])*dat[n];
+    nrm = sqrt(nrm);
+    if(nrm == 0) return;
+
+    const float f = 1./nrm;
+    for(size_t n = 0; n < dat.size(); ++n) dat[n] *= f;
+    scale_ *= nrm;
+    }
+
+void ITFloat::
+product(const ITensor& A, ITensor& res) const
+    {
+    if(isNull()) Error("ITFloat is null");
+    ITFloat Af(A);
+    Af *= *this;
+    res = Af.toTensor();
+    }
+
+
 //Non-contracting product: Cikj = Aij Bkj (no sum over j)
 ITensor& ITensor::
 operator/=(const ITensor& other)
@@ -1654,7 +2141,7 @@ operator/=(const ITensor& other)
     
     scale_ *= other.scale_;
 
-    scaleOutNorm();
+    scaleOutNormLazy();
 
     return *this;
     }
@@ -1682,6 +2169,11 @@ directMultiply(const ITensor& L,
 
     int nl[NMAX];
     int nr[NMAX];
+    for(int n = 0; n < NMAX; ++n)
+        {
+        nl[n] = 1;
+        nr[n] = 1;
+        }
 
     const IndexSet<Index>& Lis = L.indices();
     const IndexSet<Index>& Ris = R.indices();
@@ -1733,16 +2225,35 @@ directMultiply(const ITensor& L,
     const Real* pR = R.datStart();
     Real* pN = newdat.Store();
 
+    if(trn <= 8 && orn <= 8)
+        {
+        for(; u.notDone(); ++u)
+            {
+            Real& val = pN[u.ind];
+            val = 0;
+            for(c.reset(); c.notDone(); ++c)
+                {
+                val += pL[((((((((*li[7])*nl[6]+*li[6])*nl[5]+*li[5])*nl[4]+*li[4])
+                          *nl[3]+*li[3])*nl[2]+*li[2])*nl[1]+*li[1])*nl[0]+*li[0])]
+                     * pR[((((((((*ri[7])*nr[6]+*ri[6])*nr[5]+*ri[5])*nr[4]+*ri[4])
+                          *nr[3]+*ri[3])*nr[2]+*ri[2])*nr[1]+*ri[1])*nr[0]+*ri[0])];
+                }
+            }
+        return;
+        }
+
+    //Rank > 8 (possible if NMAX > 8)
     for(; u.notDone(); ++u)
         {
         Real& val = pN[u.ind];
         val = 0;
         for(c.reset(); c.notDone(); ++c)
             {
-            val += pL[((((((((*li[7])*nl[6]+*li[6])*nl[5]+*li[5])*nl[4]+*li[4])
-                      *nl[3]+*li[3])*nl[2]+*li[2])*nl[1]+*li[1])*nl[0]+*li[0])]
-                 * pR[((((((((*ri[7])*nr[6]+*ri[6])*nr[5]+*ri[5])*nr[4]+*ri[4])
-                      *nr[3]+*ri[3])*nr[2]+*ri[2])*nr[1]+*ri[1])*nr[0]+*ri[0])];
+            int l = 0, 
+                r = 0;
+            for(int j = trn-1; j >= 0; --j) l = l*nl[j]+*li[j];
+            for(int j = orn-1; j >= 0; --j) r = r*nr[j]+*ri[j];
+            val += pL[l]*pR[r];
             }
         }
 
@@ -1762,13 +2273,16 @@ operator*=(const ITensor& other)
         Error("Null ITensor in product");
 
     //Complex types are treated as just another index, of type ReIm
-    //Multiplication is handled automatically with these simple tensor helpers
+    //The product of two complex tensors is computed from
+    //their real and imaginary parts using three real products
+    //  Re = ArBr - AiBi, Im = (Ar+Ai)(Br+Bi) - ArBr - AiBi
+    //instead of contracting with ComplexProd (which costs
+    //four real products and an extra rank-3 contraction)
     if(hasindex(*this,Index::IndReIm()) && hasindex(other,Index::IndReIm()) && 
 	    !hasindex(other,Index::IndReImP()) && !hasindex(other,Index::IndReImPP()) 
 	    && !hasindex(*this,Index::IndReImP()) && !hasindex(*this,Index::IndReImPP()))
         {
-        this->prime(ReIm);
-        operator*=(ComplexProd() * primed(other,ReIm,2));
+        complexProduct(*this,other);
         return *this;
         }
 
@@ -1808,7 +2322,7 @@ operator*=(const ITensor& other)
             {
             std::cout << "new r_ would be = " << is_.r() << "\n";
             std::cerr << "new r_ would be = " << is_.r() << "\n";
-            Error("ITensor::operator*=: too many uncontracted indices in product (max is 8)");
+            Error("ITensor::operator*=: too many uncontracted indices in product (max is NMAX)");
             }
 #endif
         for(int j = 1; j <= is_.rn(); ++j)
@@ -1829,7 +2343,7 @@ operator*=(const ITensor& other)
             {
             std::cout << "new r_ would be = " << is_.r() << "\n";
             std::cerr << "new r_ would be = " << is_.r() << "\n";
-            Error("ITensor::operator*=: too many uncontracted indices in product (max is 8)");
+            Error("ITensor::operator*=: too many uncontracted indices in product (max is NMAX)");
             }
 #endif
         for(int j = 1; j <= other.is_.rn(); ++j) 
@@ -1850,7 +2364,7 @@ operator*=(const ITensor& other)
         Print(props.nsamen);
         cerr << "new m==1 indices\n";
         for(int j = 1; j <= nr1_; ++j) cerr << *(new_index1_.at(j)) << "\n";
-        Error("ITensor::operator*=: too many uncontracted indices in product (max is 8)");
+        Error("ITensor::operator*=: too many uncontracted indices in product (max is NMAX)");
         }
 #endif
 
@@ -1898,13 +2412,132 @@ operator*=(const ITensor& other)
 
     scale_ *= other.scale_;
 
-    scaleOutNorm();
+    scaleOutNormLazy();
 
     return *this;
     } //ITensor::operator*=(ITensor)
 
 
 
+//
+// Fused permute, scale and accumulate:
+//
+//     out = alpha*in + beta*P(src)
+//
+// where in and out have the index order dis and src
+// has the index order sis (in may equal out).
+// Dimensions are walked in the storage order of src;
+// when the fastest dimensions of src and dis differ,
+// the pair is traversed in square tiles (as in a blocked
+// transpose) so both are read and written in cache lines.
+//
+static void
+permuteAxpby(Real alpha, const Real* in, Real* out, const IndexSet<Index>& dis,
+             Real beta, const Real* src, const IndexSet<Index>& sis)
+    {
+    const int r = sis.rn();
+    if(r == 0)
+        {
+        out[0] = alpha*in[0] + beta*src[0];
+        return;
+        }
+
+    array<int,NMAX+1> dpos;
+    dpos[0] = 1;
+    for(int k = 1; k < dis.rn(); ++k)
+        dpos[k] = dpos[k-1]*dis[k-1].m();
+
+    //n, sstr, dstr: size and strides (in src and out)
+    //of each dimension of src
+    array<int,NMAX+1> n, sstr, dstr;
+    bool same_order = true;
+    int q = 0;
+    for(int k = 0; k < r; ++k)
+        {
+        n[k] = sis[k].m();
+        sstr[k] = (k == 0 ? 1 : sstr[k-1]*n[k-1]);
+        dstr[k] = dpos[findindex(dis,sis[k])];
+        if(dstr[k] != sstr[k]) same_order = false;
+        if(dstr[k] == 1) q = k;
+        }
+
+    if(same_order)
+        {
+        const int len = sstr[r-1]*n[r-1];
+        if(alpha == 1)
+            {
+            for(int i = 0; i < len; ++i) out[i] = in[i] + beta*src[i];
+            }
+        else
+            {
+            for(int i = 0; i < len; ++i) out[i] = alpha*in[i] + beta*src[i];
+            }
+        return;
+        }
+
+    //Remaining dimensions, walked by an odometer
+    array<int,NMAX+1> on, os, od, oi;
+    int no = 0;
+    for(int k = 1; k < r; ++k)
+        {
+        if(k == q) continue;
+        on[no] = n[k];
+        os[no] = sstr[k];
+        od[no] = dstr[k];
+        oi[no] = 0;
+        ++no;
+        }
+
+    const int n0 = n[0],
+              d0 = dstr[0];
+    const int nq = (q == 0 ? 1 : n[q]),
+              sq = (q == 0 ? 0 : sstr[q]);
+    const int B = 16;
+
+    int so = 0, 
+        doff = 0;
+    while(true)
+        {
+        if(q == 0)
+            {
+            //Fastest dimension is shared
+            const Real* s = src+so;
+            const Real* a = in+doff;
+            Real* o = out+doff;
+            for(int i = 0; i < n0; ++i) o[i] = alpha*a[i] + beta*s[i];
+            }
+        else
+            {
+            for(int ib = 0; ib < n0; ib += B)
+            for(int qb = 0; qb < nq; qb += B)
+                {
+                const int ie = std::min(ib+B,n0),
+                          qe = std::min(qb+B,nq);
+                for(int iq = qb; iq < qe; ++iq)
+                    {
+                    const Real* s = src+so+iq*sq;
+                    const Real* a = in+doff+iq;
+                    Real* o = out+doff+iq;
+                    for(int i = ib; i < ie; ++i) 
+                        o[i*d0] = alpha*a[i*d0] + beta*s[i];
+                    }
+                }
+            }
+
+        int j = 0;
+        for(; j < no; ++j)
+            {
+            so += os[j];
+            doff += od[j];
+            if(++oi[j] < on[j]) break;
+            so -= on[j]*os[j];
+            doff -= on[j]*od[j];
+            oi[j] = 0;
+            }
+        if(j == no) break;
+        }
+    }
+
 ITensor& ITensor::
 operator+=(const ITensor& other)
     {
@@ -1944,94 +2577,28 @@ operator+=(const ITensor& other)
         return *this; 
         }
 
-    solo();
-
-    Vector& thisdat = p->v;
-    const Vector& othrdat = other.p->v;
-
-    Real scalefac = 1;
+    //Reconcile the scale factors within the
+    //same pass over the data as the addition
+    Real alpha = 1,
+         beta = 1;
     if(scale_.magnitudeLessThan(other.scale_)) 
         {
-        this->scaleTo(other.scale_); 
-        }
-    else
-        {
-        scalefac = (other.scale_/scale_).real();
-        }
-
-    bool same_ind_order = true;
-    for(int j = 0; j < is_.rn(); ++j)
-    if(is_[j] != other.is_[j])
-        { 
-        same_ind_order = false; 
-        break; 
-        }
-
-    if(same_ind_order) 
-        { 
-        if(scalefac == 1)
-            thisdat += othrdat; 
-        else
-            thisdat += scalefac*othrdat;
-        return *this; 
-        }
-
-    Permutation P; 
-    getperm(is_,other.is_,P);
-    Counter c(other.is_);
-
-    const int* j[NMAX+1];
-    for(int k = 1; k <= NMAX; ++k) 
-        {
-        j[P.dest(k)] = &(c.i[k]);
-        }
-
-    int n[NMAX+1];
-    for(int k = 1; k <= NMAX; ++k) 
-        {
-        n[P.dest(k)] = c.n[k];
-        }
-
-//#ifdef STRONG_DEBUG
-    //Real tot_this = thisdat.sumels();
-    //Real tot_othr = othrdat.sumels();
-//#endif
-
-    if(scalefac == 1)
-        {
-        for(; c.notDone(); ++c)
-            {
-            thisdat[(((((((*j[8])*n[7]+*j[7])*n[6]
-            +*j[6])*n[5]+*j[5])*n[4]+*j[4])*n[3]
-            +*j[3])*n[2]+*j[2])*n[1]+*j[1]]
-            += othrdat[c.ind];
-            }
+        alpha = (scale_/other.scale_).real();
+        scale_ = other.scale_;
         }
     else
         {
-        for(; c.notDone(); ++c)
-            {
-            thisdat[(((((((*j[8])*n[7]+*j[7])*n[6]
-            +*j[6])*n[5]+*j[5])*n[4]+*j[4])*n[3]
-            +*j[3])*n[2]+*j[2])*n[1]+*j[1]]
-            += scalefac * othrdat[c.ind];
-            }
+        beta = (other.scale_/scale_).real();
         }
 
+    //If the data is shared, write the
+    //result to new storage instead of copying first
+    const bool shared = !p.unique();
+    shared_ptr<ITDat> oldp(p);
+    if(shared) allocate(oldp->v.Length());
 
-    /*
-#ifdef STRONG_DEBUG
-    Real new_tot = thisdat.sumels();
-    Real compare = tot_this + scalefac*tot_othr;
-    Real ref = Norm(thisdat);
-    if(fabs(compare) > 1E-12 && fabs(new_tot-compare) > 1E-12 * ref)
-	{
-	Real di = new_tot - compare;
-	cerr << format("new_tot = %f, compare = %f, dif = %f\n")%new_tot%compare%di;
-	Error("Incorrect sum");
-	}
-#endif
-    */
+    permuteAxpby(alpha,oldp->v.Store(),p->v.Store(),is_,
+                 beta,other.p->v.Store(),other.is_);
 
     return *this;
     } 
@@ -2090,8 +2657,21 @@ toMatrix11NoScale(const Index& i1, const Index& i2, Matrix& res) const
 void ITensor::
 toMatrix11(const Index& i1, const Index& i2, Matrix& res) const
     { 
-    toMatrix11NoScale(i1,i2,res); 
-    res *= scale_.real(); 
+    toMatrix11(i1,i2,res,LogNumber(1));
+    }
+
+void ITensor::
+toMatrix11(const Index& i1, const Index& i2, Matrix& res,
+           const LogNumber& unit) const
+    {
+    if(r() != 2) Error("toMatrix11: incorrect rank");
+    assert(hasindex(*this,i1));
+    assert(hasindex(*this,i2));
+    res.ReDimension(i1.m(),i2.m());
+
+    MatrixRef dref; 
+    p->v.TreatAsMatrix(dref,is_[1].m(),is_[0].m());
+    res = dref.t(i1==is_[0])*(scale_/unit).real0(); 
     }
 
 void ITensor::
@@ -2473,3 +3053,104 @@ BraKet(const ITensor& x, const ITensor& y, Real& re, Real& im)
     im = 0;
     }
 
+void
+linearComb(const std::vector<ITensor>& T, const VectorRef& c, ITensor& res)
+    {
+    const int n = c.Length();
+    if(n == 0 || n > int(T.size())) 
+        Error("linearComb: number of coefficients must be in [1,T.size()]");
+
+    const ITensor& T0 = T.front();
+    const Real ur = T0.is_.uniqueReal();
+    bool mixed = false;
+    for(int k = 0; k < n; ++k)
+        {
+        if(fabs(T[k].is_.uniqueReal()-ur) > 1E-12)
+            {
+            Print(T0);
+            Print(T[k]);
+            Error("linearComb: unique Reals don't match (different Index structure).");
+            }
+        if(isComplex(T[k]) != isComplex(T0)) mixed = true;
+        }
+
+    //Mixed real and complex terms are promoted by operator+=
+    if(mixed)
+        {
+        ITensor r = c(1)*T0;
+        for(int k = 1; k < n; ++k) r += c(k+1)*T[k];
+        res.swap(r);
+        return;
+        }
+
+    //Use the scale of the largest term so that
+    //the coefficients f[k] are all at most 1
+    vector<LogNumber> s(n);
+    LogNumber big(0);
+    for(int k = 0; k < n; ++k)
+        {
+        s[k] = T[k].scale_;
+        s[k] *= c(k+1);
+        if(big.magnitudeLessThan(s[k])) big = s[k];
+        }
+    if(big.sign() == 0)
+        {
+        ITensor r(T0);
+        r *= 0;
+        res.swap(r);
+        return;
+        }
+    vector<Real> f(n,0);
+    for(int k = 0; k < n; ++k)
+        {
+        if(s[k].sign() != 0) f[k] = (s[k]/big).real();
+        }
+
+    ITensor r;
+    r.is_ = T0.is_;
+    r.scale_ = big;
+    r.allocate(T0.p->v.Length());
+    Real* const rdat = r.p->v.Store();
+    const int len = r.p->v.Length();
+
+    //Terms with the same index order as T0 are
+    //summed chunk by chunk, so that each chunk
+    //of the result stays in cache while all
+    //terms are added to it
+    vector<int> same, perm;
+    for(int k = 0; k < n; ++k)
+        {
+        if(f[k] == 0) continue;
+        bool same_ind_order = true;
+        for(int j = 0; j < T0.is_.rn(); ++j)
+        if(T0.is_[j] != T[k].is_[j])
+            {
+            same_ind_order = false;
+            break;
+            }
+        (same_ind_order ? same : perm).push_back(k);
+        }
+
+    const int chunk = 1024;
+    for(int b = 0; b < len && !same.empty(); b += chunk)
+        {
+        const int e = min(b+chunk,len);
+        const Real f0 = f[same.front()];
+        const Real* s0 = T[same.front()].p->v.Store();
+        for(int i = b; i < e; ++i) rdat[i] = f0*s0[i];
+        for(size_t t = 1; t < same.size(); ++t)
+            {
+            const Real ft = f[same[t]];
+            const Real* st = T[same[t]].p->v.Store();
+            for(int i = b; i < e; ++i) rdat[i] += ft*st[i];
+            }
+        }
+
+    Foreach(int k, perm)
+        {
+        permuteAxpby(1,rdat,rdat,r.is_,f[k],T[k].p->v.Store(),T[k].is_);
+        }
+
+    res.swap(r);
+    }
+
@@ -23,6 +23,7 @@ struct ProductProps;
 class Combiner;
 class ITDat;
 class ITSparse;
+class ITFloat;
 
 //
 // ITensor
@@ -290,6 +291,9 @@ class ITensor
     // RiJ = Ai(jk) <-- Here J represents the grouped pair of indices (jk)
     //                  If j.m() == 5 and k.m() == 7, J.m() == 5*7.
     //
+    // If the grouped indices are already adjacent and in order
+    // in this ITensor, res shares its data (no copy is made).
+    //
     void 
     groupIndices(const boost::array<Index,NMAX+1>& indices, int nind, 
                       const Index& grouped, ITensor& res) const;
@@ -351,6 +355,25 @@ class ITensor
     void 
     expandIndex(const Index& small, const Index& big, int start);
 
+    //
+    // insertSlab copies the elements of t into this ITensor at 
+    // J = start+1...start+small.m() of its Index big, where t has 
+    // Index small in place of big and otherwise the same indices 
+    // (in any order). Elements outside this range are unchanged.
+    //
+    void
+    insertSlab(const ITensor& t, const Index& small, 
+               const Index& big, int start);
+
+    //
+    // slab is the reverse of insertSlab: it returns the elements 
+    // at J = start+1...start+small.m() of Index big, with Index 
+    // small in place of big. If small.m() == big.m() the 
+    // result shares the data of this ITensor.
+    //
+    ITensor
+    slab(const Index& big, const Index& small, int start) const;
+
     //Set components of rank 2 ITensor using Matrix M as input
     void 
     fromMatrix11(const Index& i1, const Index& i2, const Matrix& M);
@@ -359,6 +382,14 @@ class ITensor
     void 
     toMatrix11(const Index& i1, const Index& i2, Matrix& res) const;
 
+    //Convert rank 2 ITensor to a Matrix whose elements are
+    //given in units of unit (that is, divided by unit).
+    //The scale factor is applied while copying, so this is
+    //cheaper than calling scaleTo(unit) then toMatrix11NoScale.
+    void 
+    toMatrix11(const Index& i1, const Index& i2, Matrix& res,
+               const LogNumber& unit) const;
+
     //Convert rank 2 ITensor to a Matrix, but do not include
     //scale factor in result
     void 
@@ -469,6 +500,9 @@ class ITensor
     typedef ITSparse
     SparseT;
 
+    typedef ITFloat
+    FloatT;
+
     static 
     const Index& 
     ReImIndex() { return Index::IndReIm(); }
@@ -591,6 +625,11 @@ class ITensor
     //objects even though they may share data
     void 
     solo();
+
+    //Like scaleOutNorm, but only rescales the data
+    //if its norm is far from 1 (used after products)
+    void
+    scaleOutNormLazy();
     
     friend struct ProductProps;
 
@@ -611,9 +650,14 @@ class ITensor
 
     friend class ITSparse;
 
+    friend class ITFloat;
+
     friend void 
     product(const ITSparse& S, const ITensor& T, ITensor& res);
 
+    friend void
+    linearComb(const std::vector<ITensor>& T, const VectorRef& c, ITensor& res);
+
     }; // class ITensor
 
 
@@ -650,6 +694,75 @@ class commaInit
 
     };
 
+//
+// ITFloat
+//
+// Single-precision copy of an ITensor, used to do the 
+// bandwidth-bound products of LocalOp and LocalMPO in 
+// single precision (see floatProduct in localop.h).
+// The data are normalized when converted, so products 
+// of ITFloats stay far from float overflow. Copies
+// of an ITFloat share its data.
+//
+class ITFloat
+    {
+    public:
+
+    typedef ITensor
+    TensorT;
+
+    ITFloat();
+
+    explicit
+    ITFloat(const ITensor& T);
+
+    bool
+    isNull() const { return !p_; }
+
+    const IndexSet<Index>&
+    indices() const { return is_; }
+
+    int
+    r() const { return is_.r(); }
+
+    const LogNumber&
+    scale() const { return scale_; }
+
+    //Converts back to double precision
+    ITensor
+    toTensor() const;
+
+    //Contracting product, done by sgemm
+    ITFloat&
+    operator*=(const ITFloat& other);
+
+    ITFloat
+    operator*(const ITFloat& other) const 
+        { ITFloat res(*this); res *= other; return res; }
+
+    //Other must have the same indices,
+    //possibly in a different order
+    ITFloat&
+    operator+=(const ITFloat& other);
+
+    //Computes res = A * T in single precision,
+    //converting A and the result once
+    //(res may be the same object as A)
+    void
+    product(const ITensor& A, ITensor& res) const;
+
+    private:
+
+    IndexSet<Index> is_;
+    LogNumber scale_;
+    boost::shared_ptr<std::vector<float> > p_;
+
+    //Moves the norm of the data into scale_
+    void
+    scaleOutNorm();
+
+    };
+
 //
 // ITDat
 //
@@ -705,38 +818,55 @@ class ITDat
 
     };
 
+//
+// Returns a tensor holding the data of T, leaving T null.
+// Used by the operators below to return their by-value
+// argument: such arguments live until the end of the
+// calling expression, so returning a copy would leave the
+// result sharing its data with them (and force a deep copy
+// when the result is next modified).
+//
+template <class Tensor>
+Tensor
+takeData(Tensor& T)
+    {
+    Tensor res;
+    res.swap(T);
+    return res;
+    }
+
 ITensor inline
-operator*(ITensor A, const ITensor& B) { A *= B; return A; }
+operator*(ITensor A, const ITensor& B) { A *= B; return takeData(A); }
 
 ITensor inline
-operator*(ITensor T, const IndexVal& iv) { T *= iv; return T; }
+operator*(ITensor T, const IndexVal& iv) { T *= iv; return takeData(T); }
 
 ITensor inline
 operator*(const IndexVal& iv, const ITensor& t) { return (ITensor(iv) *= t); }
 
 ITensor inline
-operator*(ITensor T, Real fac) { T *= fac; return T; }
+operator*(ITensor T, Real fac) { T *= fac; return takeData(T); }
 
 ITensor inline
-operator*(Real fac, ITensor T) { T *= fac; return T; }
+operator*(Real fac, ITensor T) { T *= fac; return takeData(T); }
 
 ITensor inline
-operator/(ITensor T, Real fac) { T /= fac; return T; }
+operator/(ITensor T, Real fac) { T /= fac; return takeData(T); }
 
 ITensor inline
-operator*(ITensor T, LogNumber lgnum) { T *= lgnum; return T; }
+operator*(ITensor T, LogNumber lgnum) { T *= lgnum; return takeData(T); }
 
 ITensor inline
-operator*(LogNumber lgnum, ITensor T) { T *= lgnum; return T; }
+operator*(LogNumber lgnum, ITensor T) { T *= lgnum; return takeData(T); }
 
 ITensor inline
-operator/(ITensor A, const ITensor& B) { A /= B; return A; }
+operator/(ITensor A, const ITensor& B) { A /= B; return takeData(A); }
 
 ITensor inline
-operator+(ITensor A, const ITensor& B) { A += B; return A; }
+operator+(ITensor A, const ITensor& B) { A += B; return takeData(A); }
 
 ITensor inline
-operator-(ITensor A, const ITensor& B) { A -= B; return A; }
+operator-(ITensor A, const ITensor& B) { A -= B; return takeData(A); }
 
 template <typename Callable> 
 void ITensor::
@@ -771,6 +901,19 @@ Dot(const ITensor& x, const ITensor& y);
 void 
 BraKet(const ITensor& x, const ITensor& y, Real& re, Real& im);
 
+//
+// Sets res to the linear combination
+//
+//     c(1)*T[0] + c(2)*T[1] + ... + c(n)*T[n-1]
+//
+// where n = c.Length() (at most T.size()).
+// Makes a single pass over the memory of res
+// instead of one pass per term as repeated
+// use of operator+= would.
+//
+void
+linearComb(const std::vector<ITensor>& T, const VectorRef& c, ITensor& res);
+
 //
 // Define product of IndexVal iv1 = (I1,n1), iv2 = (I2,n2)
 // (I1, I2 are Index objects; n1,n2 are type int)
@@ -981,6 +1124,39 @@ imagPart(const Tensor& T)
     return im;
     }
 
+//
+// Replaces A by the product A*B of two complex tensors
+// (both having a ReIm index) using three real products:
+//   Re(AB) = ArBr - AiBi
+//   Im(AB) = (Ar+Ai)(Br+Bi) - ArBr - AiBi
+//
+template <class Tensor>
+void
+complexProduct(Tensor& A, const Tensor& B)
+    {
+    Tensor ar = realPart(A),
+           ai = imagPart(A),
+           br = realPart(B),
+           bi = imagPart(B);
+
+    Tensor rr(ar);
+    rr *= br;
+    Tensor ii(ai);
+    ii *= bi;
+
+    ar += ai;
+    br += bi;
+    ar *= br;
+    ar -= rr;
+    ar -= ii;
+
+    rr -= ii;
+    rr *= Tensor::Complex_1();
+    ar *= Tensor::Complex_i();
+    rr += ar;
+    A.swap(rr);
+    }
+
 //
 // Tracing over all indices results in a Real
 //
@@ -1034,6 +1210,41 @@ _ind(const IndexSet<Index>& is,
      int i1, int i2, int i3, int i4, 
      int i5, int i6, int i7, int i8);
 
+//
+// Versions of _ind for tensors of any rank,
+// taking the index values from i[1],...,i[is.rn()]
+// or from *ii[1],...,*ii[is.rn()]
+// (all NMAX+1 entries of i or ii must be valid)
+//
+// NMAX is a compile-time constant, so with the default 
+// NMAX of 8 these reduce to the unrolled 8 argument 
+// version, with no test of the rank
+//
+inline int
+_ind(const IndexSet<Index>& is, const boost::array<int,NMAX+1>& i)
+    {
+    const int rn = is.rn();
+    if(NMAX <= 8 || rn <= 8) 
+        return _ind(is,i[1],i[2],i[3],i[4],i[5],i[6],i[7],i[8]);
+    int res = i[rn];
+    for(int j = rn-1; j >= 1; --j) 
+        res = res*is.m(j)+i[j];
+    return res;
+    }
+
+inline int
+_ind(const IndexSet<Index>& is, const boost::array<const int*,NMAX+1>& ii)
+    {
+    const int rn = is.rn();
+    if(NMAX <= 8 || rn <= 8) 
+        return _ind(is,*ii[1],*ii[2],*ii[3],*ii[4],
+                       *ii[5],*ii[6],*ii[7],*ii[8]);
+    int res = *ii[rn];
+    for(int j = rn-1; j >= 1; --j) 
+        res = res*is.m(j)+(*ii[j]);
+    return res;
+    }
+
 std::ostream& 
 operator<<(std::ostream & s, const ITensor& T);
 
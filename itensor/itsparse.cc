@@ -277,6 +277,17 @@ scaleTo(LogNumber newscale) const
     scale_ = newscale;
     }
 
+void ITSparse::
+swap(ITSparse& other)
+    {
+    Vector tmp;
+    tmp.CopyDestroy(diag_);
+    diag_.CopyDestroy(other.diag_);
+    other.diag_.CopyDestroy(tmp);
+    is_.swap(other.is_);
+    scale_.swap(other.scale_);
+    }
+
 void ITSparse::
 read(std::istream& s)
     {
@@ -440,6 +451,71 @@ product(const ITSparse& S, const ITensor& T, ITensor& res)
         return;
         }
 
+    //Diagonal matrix contracted with one Index of T,
+    //such as singular values multiplied into an MPS tensor:
+    //just a scaling of each slice of T along that Index
+    if(ncon == 1 && S.r() == 2 && S.rn() == 2
+       && S.m(1) == dsize && S.m(2) == dsize)
+        {
+        //Position k of the contracted Index in T
+        const int sc = (scon[1] != 0 ? 1 : 2);
+        const int k = scon[sc];
+
+        //res has the other Index of S in place of it,
+        //so that res has the same layout as T
+        res.is_.clear();
+        for(int j = 1; j <= T.r(); ++j)
+            res.is_.addindex(j == k ? S.index(3-sc) : T.is_.index(j));
+
+        if(S.diagAllSame())
+            {
+            res.p = T.p;
+            return;
+            }
+
+        //Elements of T are T[l + left*(i + dsize*r)]
+        //where i is the value of the contracted Index
+        int left = 1, 
+            right = 1;
+        for(int j = 1; j < k; ++j) left *= T.is_.index(j).m();
+        for(int j = k+1; j <= T.is_.rn(); ++j) right *= T.is_.index(j).m();
+
+        if(res.isNull() || !res.p.unique() || res.p == T.p)
+            res.p = make_shared<ITDat>(alloc_size); 
+        else
+            res.p->v.ReDimension(alloc_size);
+
+        const Real* const d = S.diag_.Store();
+        const Real* tp = T.p->v.Store();
+        Real* rp = res.p->v.Store();
+
+        if(left == 1)
+            {
+            //Contracted Index first: multiply 
+            //each column of T by the diagonal
+            for(int r = 0; r < right; ++r, tp += dsize, rp += dsize)
+            for(int i = 0; i < dsize; ++i)
+                {
+                rp[i] = d[i]*tp[i];
+                }
+            }
+        else
+            {
+            //Otherwise scale each contiguous 
+            //block of length left by one diagonal element
+            for(int r = 0; r < right; ++r)
+            for(int i = 0; i < dsize; ++i, tp += left, rp += left)
+                {
+                const Real di = d[i];
+                for(int l = 0; l < left; ++l)
+                    {
+                    rp[l] = di*tp[l];
+                    }
+                }
+            }
+        return;
+        }
+
     //Allocate a new dat for res if necessary
     if(res.isNull() || !res.p.unique())
         { 
@@ -471,14 +547,8 @@ product(const ITSparse& S, const ITensor& T, ITensor& res)
             for(tc.reset(); tc.notDone(); ++tc)
             for(diag_ind = 0; diag_ind < dsize; ++diag_ind)
                 {
-                resdat[_ind(res.is_,*ri[1],*ri[2],
-                                    *ri[3],*ri[4],
-                                    *ri[5],*ri[6],
-                                    *ri[7],*ri[8])]
-                 =  Tdat[_ind(T.is_,*ti[1],*ti[2],
-                                    *ti[3],*ti[4],
-                                    *ti[5],*ti[6],
-                                    *ti[7],*ti[8])];
+                resdat[_ind(res.is_,ri)]
+                 =  Tdat[_ind(T.is_,ti)];
                 }
             }
         else
@@ -491,15 +561,9 @@ product(const ITSparse& S, const ITensor& T, ITensor& res)
                 for(diag_ind = 0; diag_ind < dsize; ++diag_ind)
                     {
                     val +=
-                    Tdat[_ind(T.is_,*ti[1],*ti[2],
-                                    *ti[3],*ti[4],
-                                    *ti[5],*ti[6],
-                                    *ti[7],*ti[8])];
+                    Tdat[_ind(T.is_,ti)];
                     }
-                resdat[_ind(res.is_,*ri[1],*ri[2],
-                                    *ri[3],*ri[4],
-                                    *ri[5],*ri[6],
-                                    *ri[7],*ri[8])]
+                resdat[_ind(res.is_,ri)]
                 = val;
                 }
             }
@@ -513,15 +577,9 @@ product(const ITSparse& S, const ITensor& T, ITensor& res)
             for(tc.reset(); tc.notDone(); ++tc)
             for(diag_ind = 0; diag_ind < dsize; ++diag_ind)
                 {
-                resdat[_ind(res.is_,*ri[1],*ri[2],
-                                    *ri[3],*ri[4],
-                                    *ri[5],*ri[6],
-                                    *ri[7],*ri[8])]
+                resdat[_ind(res.is_,ri)]
                  = S.diag_[diag_ind] 
-                   * Tdat[_ind(T.is_,*ti[1],*ti[2],
-                                     *ti[3],*ti[4],
-                                     *ti[5],*ti[6],
-                                     *ti[7],*ti[8])];
+                   * Tdat[_ind(T.is_,ti)];
                 }
             }
         else
@@ -534,15 +592,9 @@ product(const ITSparse& S, const ITensor& T, ITensor& res)
                     {
                     val +=
                     S.diag_[diag_ind] 
-                    * Tdat[_ind(T.is_,*ti[1],*ti[2],
-                                      *ti[3],*ti[4],
-                                      *ti[5],*ti[6],
-                                      *ti[7],*ti[8])];
+                    * Tdat[_ind(T.is_,ti)];
                     }
-                resdat[_ind(res.is_,*ri[1],*ri[2],
-                                    *ri[3],*ri[4],
-                                    *ri[5],*ri[6],
-                                    *ri[7],*ri[8])]
+                resdat[_ind(res.is_,ri)]
                 = val;
                 }
             }
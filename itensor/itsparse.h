@@ -208,6 +208,11 @@ class ITSparse
     void 
     scaleTo(LogNumber newscale) const;
 
+    //Exchanges the contents of this ITSparse
+    //and other without copying the diagonal
+    void
+    swap(ITSparse& other);
+
     void
     read(std::istream& s);
 
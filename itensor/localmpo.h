@@ -37,6 +37,9 @@ class LocalMPO
     typedef typename Tensor::CombinerT
     CombinerT;
 
+    typedef typename Tensor::FloatT
+    FloatT;
+
     //
     // Constructors
     //
@@ -113,11 +116,14 @@ class LocalMPO
         RHlim_ = Op_->N()+1;
         }
 
+    //While floatProduct is true, only float copies
+    //of the edge tensors are kept and L() and R()
+    //are null tensors
     const Tensor&
     L() const { return PH_[LHlim_]; }
     // Replace left edge tensor at current bond
     void
-    L(const Tensor& nL) { PH_[LHlim_] = nL; }
+    L(const Tensor& nL) { setEnv(LHlim_,nL); }
     // Replace left edge tensor bordering site j
     // (so that nL includes sites < j)
     void
@@ -128,7 +134,7 @@ class LocalMPO
     R() const { return PH_[RHlim_]; }
     // Replace right edge tensor at current bond
     void
-    R(const Tensor& nR) { PH_[RHlim_] = nR; }
+    R(const Tensor& nR) { setEnv(RHlim_,nR); }
     // Replace right edge tensor bordering site j
     // (so that nR includes sites > j)
     void
@@ -143,6 +149,14 @@ class LocalMPO
     void
     combineMPO(bool val) { lop_.combineMPO(val); }
 
+    //If true, the edge tensors are made and kept 
+    //only in single precision and product is 
+    //done in single precision (see LocalOp)
+    bool
+    floatProduct() const { return lop_.floatProduct(); }
+    void
+    floatProduct(bool val);
+
     int
     numCenter() const { return nc_; }
     void
@@ -182,6 +196,7 @@ class LocalMPO
 
     const MPOt<Tensor>* Op_;
     std::vector<Tensor> PH_;
+    std::vector<FloatT> PHf_;
     int LHlim_,RHlim_;
     int nc_;
 
@@ -203,12 +218,33 @@ class LocalMPO
     void
     makeR(const MPSType& psi, int k);
 
+    void
+    makeFloatEnv(const Tensor& A, const Tensor& W, int from, int to);
+
+    void
+    setEnv(int j, const Tensor& E);
+
+    bool
+    envIsNull(int j) const { return PH_.at(j).isNull() && PHf_.at(j).isNull(); }
+
+    void
+    clearEnv(int j) { PH_.at(j) = Tensor(); PHf_.at(j) = FloatT(); }
+
+    void
+    updateLop(int b);
+
     void
     setLHlim(int val);
 
     void
     setRHlim(int val);
 
+    void
+    writeEnv(int j);
+
+    void
+    readEnv(int j);
+
     void
     initWrite();
 
@@ -238,6 +274,7 @@ LocalMPO(const MPOt<Tensor>& H,
          const OptSet& opts)
     : Op_(&H),
       PH_(H.N()+2),
+      PHf_(H.N()+2),
       LHlim_(0),
       RHlim_(H.N()+1),
       nc_(2),
@@ -256,6 +293,7 @@ LocalMPO(const MPSt<Tensor>& Psi,
          const OptSet& opts)
     : Op_(0),
       PH_(Psi.N()+2),
+      PHf_(Psi.N()+2),
       LHlim_(0),
       RHlim_(Psi.N()+1),
       nc_(2),
@@ -275,6 +313,7 @@ LocalMPO(const MPOt<Tensor>& H,
          const OptSet& opts)
     : Op_(&H),
       PH_(H.N()+2),
+      PHf_(H.N()+2),
       LHlim_(0),
       RHlim_(H.N()+1),
       nc_(2),
@@ -283,8 +322,8 @@ LocalMPO(const MPOt<Tensor>& H,
       writedir_("."),
       Psi_(0)
     { 
-    PH_[0] = LH;
-    PH_[H.N()+1] = RH;
+    setEnv(0,LH);
+    setEnv(H.N()+1,RH);
     if(opts.defined("NumCenter"))
         numCenter(opts.getInt("NumCenter"));
     }
@@ -331,7 +370,7 @@ void inline LocalMPO<Tensor>::
 L(int j, const Tensor& nL)
     {
     if(LHlim_ > j-1) setLHlim(j-1);
-    PH_[LHlim_] = nL;
+    setEnv(LHlim_,nL);
     }
 
 template <class Tensor>
@@ -339,7 +378,7 @@ void inline LocalMPO<Tensor>::
 R(int j, const Tensor& nR)
     {
     if(RHlim_ < j+1) setRHlim(j+1);
-    PH_[RHlim_] = nR;
+    setEnv(RHlim_,nR);
     }
 
 template <class Tensor>
@@ -364,7 +403,7 @@ position(int b, const MPSType& psi)
 
     if(Op_ != 0) //normal MPO case
         {
-        lop_.update(Op_->A(b),Op_->A(b+1),L(),R());
+        updateLop(b);
         }
     }
 
@@ -399,15 +438,22 @@ shift(int j, Direction dir, const Tensor& A)
             std::cout << "j-1 = " << (j-1) << ", LHlim = " << LHlim_ << std::endl;
             Error("Can only shift at LHlim");
             }
-        Tensor& E = PH_.at(LHlim_);
-        Tensor& nE = PH_.at(j);
-        nE = E * A;
-        nE *= Op_->A(j);
-        nE *= conj(primed(A));
+        if(floatProduct())
+            {
+            makeFloatEnv(A,Op_->A(j),LHlim_,j);
+            }
+        else
+            {
+            Tensor& E = PH_.at(LHlim_);
+            Tensor& nE = PH_.at(j);
+            nE = E * A;
+            nE *= Op_->A(j);
+            nE *= conj(primed(A));
+            }
         setLHlim(j);
         setRHlim(j+nc_+1);
 
-        lop_.update(Op_->A(j+1),Op_->A(j+2),L(),R());
+        updateLop(j+1);
         }
     else //dir == Fromright
         {
@@ -416,15 +462,22 @@ shift(int j, Direction dir, const Tensor& A)
             std::cout << "j+1 = " << (j+1) << ", RHlim_ = " << RHlim_ << std::endl;
             Error("Can only shift at RHlim_");
             }
-        Tensor& E = PH_.at(RHlim_);
-        Tensor& nE = PH_.at(j);
-        nE = E * A;
-        nE *= Op_->A(j);
-        nE *= conj(primed(A));
+        if(floatProduct())
+            {
+            makeFloatEnv(A,Op_->A(j),RHlim_,j);
+            }
+        else
+            {
+            Tensor& E = PH_.at(RHlim_);
+            Tensor& nE = PH_.at(j);
+            nE = E * A;
+            nE *= Op_->A(j);
+            nE *= conj(primed(A));
+            }
         setLHlim(j-nc_-1);
         setRHlim(j);
 
-        lop_.update(Op_->A(j-1),Op_->A(j),L(),R());
+        updateLop(j-1);
         }
     }
 
@@ -450,7 +503,10 @@ makeL(const MPSType& psi, int k)
             while(LHlim_ < k)
                 {
                 const int ll = LHlim_;
-                projectOp(psi,ll+1,Fromleft,PH_.at(ll),Op_->A(ll+1),PH_.at(ll+1));
+                if(floatProduct())
+                    makeFloatEnv(psi.A(ll+1),Op_->A(ll+1),ll,ll+1);
+                else
+                    projectOp(psi,ll+1,Fromleft,PH_.at(ll),Op_->A(ll+1),PH_.at(ll+1));
                 setLHlim(LHlim_+1);
                 }
             }
@@ -479,13 +535,90 @@ makeR(const MPSType& psi, int k)
             while(RHlim_ > k)
                 {
                 const int rl = RHlim_;
-                projectOp(psi,rl-1,Fromright,PH_.at(rl),Op_->A(rl-1),PH_.at(rl-1));
+                if(floatProduct())
+                    makeFloatEnv(psi.A(rl-1),Op_->A(rl-1),rl,rl-1);
+                else
+                    projectOp(psi,rl-1,Fromright,PH_.at(rl),Op_->A(rl-1),PH_.at(rl-1));
                 setRHlim(RHlim_-1);
                 }
             }
         }
     }
 
+template <class Tensor>
+void inline LocalMPO<Tensor>::
+floatProduct(bool val)
+    {
+    if(val == floatProduct()) return;
+
+    if(Op_ == 0) 
+        {
+        lop_.floatProduct(val);
+        return;
+        }
+
+    //Convert the edge tensors held in memory,
+    //keeping one copy of each
+    for(size_t j = 0; j < PH_.size(); ++j)
+        {
+        if(val && !PH_[j].isNull())
+            {
+            PHf_[j] = FloatT(PH_[j]);
+            PH_[j] = Tensor();
+            }
+        else
+        if(!val && !PHf_[j].isNull())
+            {
+            PH_[j] = PHf_[j].toTensor();
+            PHf_[j] = FloatT();
+            }
+        }
+
+    lop_.floatProduct(val);
+    if(RHlim_-LHlim_ == (nc_+1)) updateLop(LHlim_+1);
+    }
+
+template <class Tensor>
+void inline LocalMPO<Tensor>::
+setEnv(int j, const Tensor& E)
+    {
+    if(floatProduct() && Op_ != 0)
+        {
+        PHf_.at(j) = FloatT(E);
+        PH_.at(j) = Tensor();
+        }
+    else
+        {
+        PH_.at(j) = E;
+        }
+    }
+
+//
+// Makes the edge tensor PHf_[to] from PHf_[from], 
+// the MPS tensor A and the MPO tensor W entirely 
+// in single precision
+//
+template <class Tensor>
+void inline LocalMPO<Tensor>::
+makeFloatEnv(const Tensor& A, const Tensor& W, int from, int to)
+    {
+    FloatT nE(A);
+    if(!PHf_.at(from).isNull()) nE *= PHf_[from];
+    nE *= FloatT(W);
+    nE *= FloatT(conj(primed(A)));
+    PHf_.at(to) = nE;
+    }
+
+template <class Tensor>
+void inline LocalMPO<Tensor>::
+updateLop(int b)
+    {
+    if(floatProduct())
+        lop_.update(Op_->A(b),Op_->A(b+1),PHf_.at(LHlim_),PHf_.at(RHlim_));
+    else
+        lop_.update(Op_->A(b),Op_->A(b+1),L(),R());
+    }
+
 template <class Tensor>
 void inline LocalMPO<Tensor>::
 setLHlim(int val)
@@ -496,34 +629,19 @@ setLHlim(int val)
         return;
         }
 
-    if(LHlim_ != val && !PH_.at(LHlim_).isNull())
+    if(LHlim_ != val && !envIsNull(LHlim_))
         {
         //std::cerr << boost::format("Writing PH(%d) to %s\n")%LHlim_%writedir_;
-        writeToFile(PHFName(LHlim_),PH_.at(LHlim_));
-        PH_.at(LHlim_) = Tensor();
+        writeEnv(LHlim_);
         }
     LHlim_ = val;
     if(LHlim_ < 1) 
         {
         //Set to null tensor and return
-        PH_.at(LHlim_) = Tensor();
+        clearEnv(LHlim_);
         return;
         }
-    if(PH_.at(LHlim_).isNull())
-        {
-        std::string fname = PHFName(LHlim_);
-        std::ifstream s(fname.c_str());
-        if(s.good())
-            {
-            PH_.at(LHlim_).read(s);
-            s.close();
-            }
-        else
-            {
-            std::cerr << boost::format("Tried to read file %s\n")%fname;
-            Error("Missing file");
-            }
-        }
+    if(envIsNull(LHlim_)) readEnv(LHlim_);
     }
 
 template <class Tensor>
@@ -536,33 +654,53 @@ setRHlim(int val)
         return;
         }
 
-    if(RHlim_ != val && !PH_.at(RHlim_).isNull())
+    if(RHlim_ != val && !envIsNull(RHlim_))
         {
         //std::cerr << boost::format("Writing PH(%d) to %s\n")%RHlim_%writedir_;
-        writeToFile(PHFName(RHlim_),PH_.at(RHlim_));
-        PH_.at(RHlim_) = Tensor();
+        writeEnv(RHlim_);
         }
     RHlim_ = val;
     if(RHlim_ > Op_->N()) 
         {
         //Set to null tensor and return
-        PH_.at(RHlim_) = Tensor();
+        clearEnv(RHlim_);
         return;
         }
-    if(PH_.at(RHlim_).isNull())
+    if(envIsNull(RHlim_)) readEnv(RHlim_);
+    }
+
+//
+// Edge tensors held in single precision are
+// written to disk in double precision
+//
+template <class Tensor>
+void inline LocalMPO<Tensor>::
+writeEnv(int j)
+    {
+    if(PHf_.at(j).isNull())
+        writeToFile(PHFName(j),PH_.at(j));
+    else
+        writeToFile(PHFName(j),PHf_.at(j).toTensor());
+    clearEnv(j);
+    }
+
+template <class Tensor>
+void inline LocalMPO<Tensor>::
+readEnv(int j)
+    {
+    std::string fname = PHFName(j);
+    std::ifstream s(fname.c_str());
+    if(s.good())
+        {
+        Tensor E;
+        E.read(s);
+        s.close();
+        setEnv(j,E);
+        }
+    else
         {
-        std::string fname = PHFName(RHlim_);
-        std::ifstream s(fname.c_str());
-        if(s.good())
-            {
-            PH_.at(RHlim_).read(s);
-            s.close();
-            }
-        else
-            {
-            std::cerr << boost::format("Tried to read file %s\n")%fname;
-            Error("Missing file");
-            }
+        std::cerr << boost::format("Tried to read file %s\n")%fname;
+        Error("Missing file");
         }
     }
 
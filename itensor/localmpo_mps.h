@@ -60,6 +60,11 @@ class LocalMPO_MPS
     int
     size() const { return lmpo_.size(); }
 
+    bool
+    floatProduct() const { return lmpo_.floatProduct(); }
+    void
+    floatProduct(bool val) { lmpo_.floatProduct(val); }
+
     bool
     isNull() const { return Op_ == 0; }
 
@@ -47,6 +47,11 @@ class LocalMPOSet
     void
     combineMPO(bool val);
 
+    bool
+    floatProduct() const { return lmpo_.front().floatProduct(); }
+    void
+    floatProduct(bool val);
+
     int
     numCenter() const { return lmpo_.front().numCenter(); }
     void
@@ -170,6 +175,14 @@ combineMPO(bool val)
         lmpo_[n].combineMPO(val);
     }
 
+template <class Tensor>
+void inline LocalMPOSet<Tensor>::
+floatProduct(bool val)
+    {
+    for(size_t n = 0; n < lmpo_.size(); ++n)
+        lmpo_[n].floatProduct(val);
+    }
+
 template <class Tensor>
 void inline LocalMPOSet<Tensor>::
 numCenter(int val)
@@ -38,6 +38,9 @@ class LocalOp
     typedef typename Tensor::CombinerT
     CombinerT;
 
+    typedef typename Tensor::FloatT
+    FloatT;
+
     //
     // Constructors
     //
@@ -85,6 +88,12 @@ class LocalOp
     update(const Tensor& Op1, const Tensor& Op2, 
            const Tensor& L, const Tensor& R);
 
+    //Uses only the single-precision copies of 
+    //L and R (see floatProduct below)
+    void
+    update(const Tensor& Op1, const Tensor& Op2, 
+           const FloatT& Lf, const FloatT& Rf);
+
     const Tensor&
     Op1() const 
         { 
@@ -103,6 +112,7 @@ class LocalOp
     L() const 
         { 
         if(isNull()) Error("LocalOp is null");
+        if(L_ == 0) Error("LocalOp only has the float copy of L");
         return *L_;
         }
 
@@ -110,6 +120,7 @@ class LocalOp
     R() const 
         { 
         if(isNull()) Error("LocalOp is null");
+        if(R_ == 0) Error("LocalOp only has the float copy of R");
         return *R_;
         }
 
@@ -123,7 +134,15 @@ class LocalOp
     bool
     combineMPO() const { return combine_mpo_; }
     void
-    combineMPO(bool val) { combine_mpo_ = val; }
+    combineMPO(bool val) { combine_mpo_ = val; opf_.clear(); }
+
+    //If true, product is done in single precision
+    //using float copies of L, R and the MPO tensors,
+    //made when L and R are set (by update)
+    bool
+    floatProduct() const { return float_product_; }
+    void
+    floatProduct(bool val);
 
     bool
     isNull() const { return Op1_ == 0; }
@@ -148,7 +167,11 @@ class LocalOp
         L_ = other.L_;
         R_ = other.R_;
         combine_mpo_ = other.combine_mpo_;
+        float_product_ = other.float_product_;
         bond_ = other.bond_;
+        Lf_ = other.Lf_;
+        Rf_ = other.Rf_;
+        opf_ = other.opf_;
         }
 
     private:
@@ -161,8 +184,12 @@ class LocalOp
     const Tensor *Op1_, *Op2_; 
     const Tensor *L_, *R_; 
     bool combine_mpo_;
+    bool float_product_;
     mutable int size_;
     mutable Tensor bond_;
+    FloatT Lf_, Rf_;
+    //Float copies of the bond tensor (or of Op1 and Op2)
+    mutable std::vector<FloatT> opf_;
 
     //
     /////////////////
@@ -170,10 +197,23 @@ class LocalOp
     void
     makeBond() const;
 
+    void
+    productFloat(const Tensor& phi, Tensor& phip) const;
+
+    void
+    envProduct(const Tensor* E, const FloatT& Ef, Tensor& T) const;
+
+    Tensor
+    envTensor(const Tensor* E, const FloatT& Ef) const;
+
+    const std::vector<FloatT>&
+    opFloat() const;
+
     void
     processOpts(const OptSet& opts)
         {
         combine_mpo_ = opts.getBool("CombineMPO",true);
+        float_product_ = opts.getBool("FloatProduct",false);
         }
 
     };
@@ -187,6 +227,7 @@ LocalOp(const OptSet& opts)
     L_(0),
     R_(0),
     combine_mpo_(true),
+    float_product_(false),
     size_(-1)
     { 
     processOpts(opts);
@@ -202,6 +243,7 @@ LocalOp(const Tensor& Op1, const Tensor& Op2,
     L_(0),
     R_(0),
     combine_mpo_(true),
+    float_product_(false),
     size_(-1)
     {
     processOpts(opts);
@@ -219,6 +261,7 @@ LocalOp(const Tensor& Op1, const Tensor& Op2,
     L_(0),
     R_(0),
     combine_mpo_(true),
+    float_product_(false),
     size_(-1)
     {
     processOpts(opts);
@@ -235,6 +278,9 @@ update(const Tensor& Op1, const Tensor& Op2)
     R_ = 0;
     size_ = -1;
     bond_ = Tensor();
+    Lf_ = FloatT();
+    Rf_ = FloatT();
+    opf_.clear();
     }
 
 template <class Tensor>
@@ -245,13 +291,48 @@ update(const Tensor& Op1, const Tensor& Op2,
     update(Op1,Op2);
     L_ = &L;
     R_ = &R;
+    if(float_product_)
+        {
+        Lf_ = FloatT(L);
+        Rf_ = FloatT(R);
+        }
+    }
+
+template <class Tensor>
+void inline LocalOp<Tensor>::
+update(const Tensor& Op1, const Tensor& Op2, 
+       const FloatT& Lf, const FloatT& Rf)
+    {
+    update(Op1,Op2);
+    Lf_ = Lf;
+    Rf_ = Rf;
+    }
+
+template <class Tensor>
+void inline LocalOp<Tensor>::
+floatProduct(bool val)
+    {
+    float_product_ = val;
+    //Keep the float copies only while they are used,
+    //unless they are the only copies of L and R
+    if(float_product_)
+        {
+        if(L_ != 0 && Lf_.isNull()) Lf_ = FloatT(*L_);
+        if(R_ != 0 && Rf_.isNull()) Rf_ = FloatT(*R_);
+        }
+    else
+        {
+        if(L_ != 0) Lf_ = FloatT();
+        if(R_ != 0) Rf_ = FloatT();
+        opf_.clear();
+        }
     }
 
 template <class Tensor>
 bool inline LocalOp<Tensor>::
 LIsNull() const
     {
-    if(L_ == 0) return true;
+    if(L_ == 0) return Lf_.isNull();
     return L_->isNull();
     }
 
@@ -259,7 +340,7 @@ template <class Tensor>
 bool inline LocalOp<Tensor>::
 RIsNull() const
     {
-    if(R_ == 0) return true;
+    if(R_ == 0) return Rf_.isNull();
     return R_->isNull();
     }
 
@@ -269,6 +350,12 @@ product(const Tensor& phi, Tensor& phip) const
     {
     if(this->isNull()) Error("LocalOp is null");
 
+    if(float_product_)
+        {
+        productFloat(phi,phip);
+        return;
+        }
+
     const Tensor& Op1 = *Op1_;
     const Tensor& Op2 = *Op2_;
 
@@ -277,7 +364,7 @@ product(const Tensor& phi, Tensor& phip) const
         phip = phi;
 
         if(!RIsNull()) 
-            phip *= R(); //m^3 k d
+            envProduct(R_,Rf_,phip); //m^3 k d
 
         if(combine_mpo_)
             {
@@ -291,7 +378,8 @@ product(const Tensor& phi, Tensor& phip) const
         }
     else
         {
-        phip = phi * L(); //m^3 k d
+        phip = phi;
+        envProduct(L_,Lf_,phip); //m^3 k d
 
         if(combine_mpo_)
             {
@@ -304,9 +392,57 @@ product(const Tensor& phi, Tensor& phip) const
             }
 
         if(!RIsNull()) 
-            phip *= R();
+            envProduct(R_,Rf_,phip);
+        }
+
+    phip.mapprime(1,0);
+    }
+
+//
+// Same as the double precision product, 
+// but converting phi to float once and 
+// converting the result back once
+//
+template <class Tensor>
+void inline LocalOp<Tensor>::
+productFloat(const Tensor& phi, Tensor& phip) const
+    {
+    const std::vector<FloatT>& opf = opFloat();
+
+    FloatT pf(phi);
+
+    if(LIsNull())
+        {
+        if(!RIsNull()) pf *= Rf_; //m^3 k d
+
+        if(combine_mpo_)
+            {
+            pf *= opf[0];
+            }
+        else
+            {
+            pf *= opf[1]; //m^2 k^2
+            pf *= opf[0]; //m^2 k^2
+            }
+        }
+    else
+        {
+        pf *= Lf_; //m^3 k d
+
+        if(combine_mpo_)
+            {
+            pf *= opf[0];
+            }
+        else
+            {
+            pf *= opf[0]; //m^2 k^2
+            pf *= opf[1]; //m^2 k^2
+            }
+
+        if(!RIsNull()) pf *= Rf_;
         }
 
+    phip = pf.toTensor();
     phip.mapprime(1,0);
     }
 
@@ -326,12 +462,12 @@ deltaRho(const Tensor& AA, const CombinerT& comb, Direction dir) const
     Tensor delta(AA);
     if(dir == Fromleft)
         {
-        if(!LIsNull()) delta *= L();
+        if(!LIsNull()) envProduct(L_,Lf_,delta);
         delta *= (*Op1_);
         }
     else //dir == Fromright
         {
-        if(!RIsNull()) delta *= R();
+        if(!RIsNull()) envProduct(R_,Rf_,delta);
         delta *= (*Op2_);
         }
 
@@ -352,12 +488,12 @@ deltaPhi(const Tensor& phi) const
 
     if(!LIsNull()) 
         {
-        deltaL *= L();
+        envProduct(L_,Lf_,deltaL);
         }
 
     if(!RIsNull()) 
         {
-        deltaR *= R();
+        envProduct(R_,Rf_,deltaR);
         }
 
     const Tensor& Op1 = *Op1_;
@@ -388,12 +524,12 @@ deltaPhi(const IQTensor& phi) const
 
     if(!LIsNull()) 
         {
-        deltaL *= L();
+        envProduct(L_,Lf_,deltaL);
         }
 
     if(!RIsNull()) 
         {
-        deltaR *= R();
+        envProduct(R_,Rf_,deltaR);
         }
 
     const IQTensor& Op1 = *Op1_;
@@ -474,10 +610,11 @@ diag() const
 
     if(!LIsNull())
         {
+        const Tensor L = envTensor(L_,Lf_);
         found = false;
-        Foreach(const IndexT& ll, L().indices())
+        Foreach(const IndexT& ll, L.indices())
             {
-            if(ll.primeLevel() == 0 && hasindex(L(),primed(ll)))
+            if(ll.primeLevel() == 0 && hasindex(L,primed(ll)))
                 {
                 toTie = ll;
                 found = true;
@@ -485,17 +622,18 @@ diag() const
                 }
             }
         if(found)
-            Diag *= tieIndices(L(),toTie,primed(toTie),toTie);
+            Diag *= tieIndices(L,toTie,primed(toTie),toTie);
         else
-            Diag *= L();
+            Diag *= L;
         }
 
     if(!RIsNull())
         {
+        const Tensor R = envTensor(R_,Rf_);
         found = false;
-        Foreach(const IndexT& rr, R().indices())
+        Foreach(const IndexT& rr, R.indices())
             {
-            if(rr.primeLevel() == 0 && hasindex(R(),primed(rr)))
+            if(rr.primeLevel() == 0 && hasindex(R,primed(rr)))
                 {
                 toTie = rr;
                 found = true;
@@ -503,9 +641,9 @@ diag() const
                 }
             }
         if(found)
-            Diag *= tieIndices(R(),toTie,primed(toTie),toTie);
+            Diag *= tieIndices(R,toTie,primed(toTie),toTie);
         else
-            Diag *= R();
+            Diag *= R;
         }
 
     Diag.conj();
@@ -524,7 +662,7 @@ size() const
         size_ = 1;
         if(!LIsNull()) 
             {
-            Foreach(const IndexT& I, L().indices())
+            Foreach(const IndexT& I, (L_ != 0 ? L_->indices() : Lf_.indices()))
                 {
                 if(I.primeLevel() > 0)
                     {
@@ -535,7 +673,7 @@ size() const
             }
         if(!RIsNull()) 
             {
-            Foreach(const IndexT& I, R().indices())
+            Foreach(const IndexT& I, (R_ != 0 ? R_->indices() : Rf_.indices()))
                 {
                 if(I.primeLevel() > 0)
                     {
@@ -551,6 +689,47 @@ size() const
     return size_;
     }
 
+//
+// Multiplies T by the edge tensor E, or by its
+// float copy Ef if E is not available
+//
+template <class Tensor>
+void inline LocalOp<Tensor>::
+envProduct(const Tensor* E, const FloatT& Ef, Tensor& T) const
+    {
+    if(E != 0)
+        T *= *E;
+    else
+        Ef.product(T,T);
+    }
+
+template <class Tensor>
+Tensor inline LocalOp<Tensor>::
+envTensor(const Tensor* E, const FloatT& Ef) const
+    {
+    if(E != 0) return *E;
+    return Ef.toTensor();
+    }
+
+template <class Tensor>
+const std::vector<typename Tensor::FloatT>& LocalOp<Tensor>::
+opFloat() const
+    {
+    if(opf_.empty())
+        {
+        if(combine_mpo_)
+            {
+            opf_.push_back(FloatT(bondTensor()));
+            }
+        else
+            {
+            opf_.push_back(FloatT(*Op1_));
+            opf_.push_back(FloatT(*Op2_));
+            }
+        }
+    return opf_;
+    }
+
 template <class Tensor>
 void inline LocalOp<Tensor>::
 makeBond() const
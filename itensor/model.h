@@ -49,11 +49,42 @@ class Model
     IQIndex 
     siP(int i) const { return getSiP(i); }
 
+    //Site operator types, see op(t,i) below
+    enum SiteOpType 
+        { 
+        IdOp, TReverseOp, 
+        SxOp, ISyOp, SzOp, SpOp, SmOp, Sz2Op, Sx2Op, Sy2Op,
+        NOp, COp, CdagOp, AOp, AdagOp, FermiPhaseOp,
+        NupOp, NdnOp, NupdnOp, NtotOp, CupOp, CdagupOp, CdnOp, CdagdnOp,
+        AupOp, AdagupOp, AdnOp, AdagdnOp,
+        NumSiteOpTypes
+        };
+
+    //
+    // Site operator of type t at site i.
+    //
+    // Each operator is constructed only once
+    // per site and cached; the returned IQTensor
+    // shares its storage with the cached copy
+    // (modifying it triggers a copy as usual).
+    //
+    const IQTensor&
+    op(SiteOpType t, int i) const;
+
+    //
+    // ITensor version of op(t,i), also converted
+    // only once per site and cached. Useful when 
+    // building ITensor MPOs, which otherwise convert
+    // the IQTensor operator for every term.
+    //
+    const ITensor&
+    opIT(SiteOpType t, int i) const;
+
     //General Operators --------------------
 
     //Identity
     IQTensor 
-    id(int i) const { return makeId(i); }
+    id(int i) const { return op(IdOp,i); }
 
     //Projector onto state n
     IQTensor 
@@ -61,99 +92,99 @@ class Model
 
     //Time reversal operator
     IQTensor
-    tReverse(int i) const { return makeTReverse(i); }
+    tReverse(int i) const { return op(TReverseOp,i); }
 
     //Spin Operators -----------------------
 
     IQTensor 
-    sx(int i) const { return makeSx(i); }
+    sx(int i) const { return op(SxOp,i); }
 
     IQTensor 
-    isy(int i) const { return makeISy(i); }
+    isy(int i) const { return op(ISyOp,i); }
 
     IQTensor 
-    sz(int i) const { return makeSz(i); }
+    sz(int i) const { return op(SzOp,i); }
 
     IQTensor 
-    sp(int i) const { return makeSp(i); }
+    sp(int i) const { return op(SpOp,i); }
 
     IQTensor 
-    sm(int i) const { return makeSm(i); }
+    sm(int i) const { return op(SmOp,i); }
 
     //(Sz)^2, useful for spin 1 and higher
     IQTensor
-    sz2(int i) const { return makeSz2(i); }
+    sz2(int i) const { return op(Sz2Op,i); }
 
     //(Sx)^2, useful for spin 1 and higher
     IQTensor
-    sx2(int i) const { return makeSx2(i); }
+    sx2(int i) const { return op(Sx2Op,i); }
 
     //(Sy)^2, useful for spin 1 and higher
     IQTensor
-    sy2(int i) const { return makeSy2(i); }
+    sy2(int i) const { return op(Sy2Op,i); }
 
     //Particle Operators -----------------------
 
     IQTensor
-    n(int i) const { return makeN(i); }
+    n(int i) const { return op(NOp,i); }
 
     IQTensor
-    C(int i) const { return makeC(i); }
+    C(int i) const { return op(COp,i); }
 
     IQTensor
-    Cdag(int i) const { return makeCdag(i); }
+    Cdag(int i) const { return op(CdagOp,i); }
 
     IQTensor
-    A(int i) const { return makeA(i); }
+    A(int i) const { return op(AOp,i); }
 
     IQTensor
-    Adag(int i) const { return makeAdag(i); }
+    Adag(int i) const { return op(AdagOp,i); }
 
     IQTensor
-    fermiPhase(int i) const { return makeFermiPhase(i); }
+    fermiPhase(int i) const { return op(FermiPhaseOp,i); }
 
     //Hubbard Model Operators -----------
 
     IQTensor
-    Nup(int i) const { return makeNup(i); }
+    Nup(int i) const { return op(NupOp,i); }
 
     IQTensor
-    Ndn(int i) const { return makeNdn(i); }
+    Ndn(int i) const { return op(NdnOp,i); }
 
     IQTensor
-    Nupdn(int i) const { return makeNupdn(i); }
+    Nupdn(int i) const { return op(NupdnOp,i); }
 
     IQTensor
-    Ntot(int i) const { return makeNtot(i); }
+    Ntot(int i) const { return op(NtotOp,i); }
 
     IQTensor
-    Cup(int i) const { return makeCup(i); }
+    Cup(int i) const { return op(CupOp,i); }
 
     IQTensor
-    Cdagup(int i) const { return makeCdagup(i); }
+    Cdagup(int i) const { return op(CdagupOp,i); }
 
     IQTensor
-    Cdn(int i) const { return makeCdn(i); }
+    Cdn(int i) const { return op(CdnOp,i); }
 
     IQTensor
-    Cdagdn(int i) const { return makeCdagdn(i); }
+    Cdagdn(int i) const { return op(CdagdnOp,i); }
 
     IQTensor
-    Aup(int i) const { return makeAup(i); }
+    Aup(int i) const { return op(AupOp,i); }
 
     IQTensor
-    Adagup(int i) const { return makeAdagup(i); }
+    Adagup(int i) const { return op(AdagupOp,i); }
 
     IQTensor
-    Adn(int i) const { return makeAdn(i); }
+    Adn(int i) const { return op(AdnOp,i); }
 
     IQTensor
-    Adagdn(int i) const { return makeAdagdn(i); }
+    Adagdn(int i) const { return op(AdagdnOp,i); }
 
     //Other Methods -----------------------
 
     void 
-    read(std::istream& s) { doRead(s); }
+    read(std::istream& s) { clearOpCache(); doRead(s); }
 
     void 
     write(std::ostream& s) const { doWrite(s); }
@@ -167,6 +198,23 @@ class Model
 
     private:
 
+    /////////////////
+    //
+    // Data Members
+
+    //Cached operators, indexed as [type][site]
+    mutable std::vector<std::vector<IQTensor> > opcache_;
+    mutable std::vector<std::vector<ITensor> > itcache_;
+
+    //
+    /////////////////
+
+    IQTensor
+    makeOp(SiteOpType t, int i) const;
+
+    void
+    clearOpCache() { opcache_.clear(); itcache_.clear(); }
+
     virtual int
     getN() const = 0;
 
@@ -274,6 +322,107 @@ class Model
 
     };
 
+//
+// Pointer to a Model method returning a site
+// operator, for example &Model::sz or &Model::Cdag
+//
+typedef IQTensor (Model::*SiteOpMethod)(int) const;
+
+inline const IQTensor& Model::
+op(SiteOpType t, int i) const
+    {
+    if(i < 1 || i > N())
+        {
+        Print(i);
+        Error("Model: site out of range");
+        }
+    //Operators are constructed outside the critical
+    //sections so that errors (e.g. an operator not
+    //implemented by the Model) can propagate
+    IQTensor* res = 0;
+    bool empty = false;
+#ifdef _OPENMP
+#pragma omp critical(model_opcache)
+#endif
+        {
+        if(opcache_.empty())
+            {
+            opcache_.assign(NumSiteOpTypes,std::vector<IQTensor>(N()+1));
+            itcache_.assign(NumSiteOpTypes,std::vector<ITensor>(N()+1));
+            }
+        res = &(opcache_[t][i]);
+        empty = res->isNull();
+        }
+    if(empty)
+        {
+        IQTensor nop = makeOp(t,i);
+#ifdef _OPENMP
+#pragma omp critical(model_opcache)
+#endif
+        if(res->isNull()) *res = nop;
+        }
+    return *res;
+    }
+
+inline const ITensor& Model::
+opIT(SiteOpType t, int i) const
+    {
+    const IQTensor& qop = op(t,i);
+    ITensor* res = &(itcache_[t][i]);
+    bool empty = false;
+#ifdef _OPENMP
+#pragma omp critical(model_opcache)
+#endif
+    empty = res->isNull();
+    if(empty)
+        {
+        ITensor nop = qop.toITensor();
+#ifdef _OPENMP
+#pragma omp critical(model_opcache)
+#endif
+        if(res->isNull()) *res = nop;
+        }
+    return *res;
+    }
+
+inline IQTensor Model::
+makeOp(SiteOpType t, int i) const
+    {
+    switch(t)
+        {
+        case IdOp:         return makeId(i);
+        case TReverseOp:   return makeTReverse(i);
+        case SxOp:         return makeSx(i);
+        case ISyOp:        return makeISy(i);
+        case SzOp:         return makeSz(i);
+        case SpOp:         return makeSp(i);
+        case SmOp:         return makeSm(i);
+        case Sz2Op:        return makeSz2(i);
+        case Sx2Op:        return makeSx2(i);
+        case Sy2Op:        return makeSy2(i);
+        case NOp:          return makeN(i);
+        case COp:          return makeC(i);
+        case CdagOp:       return makeCdag(i);
+        case AOp:          return makeA(i);
+        case AdagOp:       return makeAdag(i);
+        case FermiPhaseOp: return makeFermiPhase(i);
+        case NupOp:        return makeNup(i);
+        case NdnOp:        return makeNdn(i);
+        case NupdnOp:      return makeNupdn(i);
+        case NtotOp:       return makeNtot(i);
+        case CupOp:        return makeCup(i);
+        case CdagupOp:     return makeCdagup(i);
+        case CdnOp:        return makeCdn(i);
+        case CdagdnOp:     return makeCdagdn(i);
+        case AupOp:        return makeAup(i);
+        case AdagupOp:     return makeAdagup(i);
+        case AdnOp:        return makeAdn(i);
+        case AdagdnOp:     return makeAdagdn(i);
+        default: Error("Model: unknown site operator type");
+        }
+    return IQTensor();
+    }
+
 inline IQTensor Model::
 makeId(int i) const
     { 
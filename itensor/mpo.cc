@@ -3,6 +3,7 @@
 //    (See accompanying LICENSE file.)
 //
 #include "hambuilder.h"
+#include "contract.h"
 
 using namespace std;
 using boost::format;
@@ -49,9 +50,12 @@ orthogonalize(const OptSet& opts)
     position(N_);
     //Now basis is ortho, ok to truncate
     svd_.useOrigM(false);
+    svd_.maxm(opts.getInt("Maxm",orig_maxm));
+    svd_.cutoff(opts.getReal("Cutoff",orig_cutoff));
+    position(1);
+
     svd_.maxm(orig_maxm);
     svd_.cutoff(orig_cutoff);
-    position(1);
 
     is_ortho_ = true;
     }
@@ -113,38 +117,53 @@ svdBond(int b, const IQTensor& AA, Direction dir, const OptSet& opts);
 
 template <class Tensor>
 MPOt<Tensor>& MPOt<Tensor>::
-operator+=(const MPOt<Tensor>& other_)
+addNoOrth(const MPOt<Tensor>& other)
     {
     if(doWrite())
-        Error("operator+= not supported if doWrite(true)");
+        Error("addNoOrth not supported if doWrite(true)");
 
-    //cout << "calling new orthog in sum" << endl;
-    if(!this->isOrtho())
-        {
-        try { 
-            orthogonalize(); 
-            }
-        catch(const ResultIsZero& rz) 
-            { 
-            *this = other_;
-            return *this;
-            }
-        }
+    Parent::directSum(other);
+    orthogonalize();
 
-    if(!other_.isOrtho())
+    return *this;
+    }
+template
+MPOt<ITensor>& MPOt<ITensor>::addNoOrth(const MPOt<ITensor>& other);
+template
+MPOt<IQTensor>& MPOt<IQTensor>::addNoOrth(const MPOt<IQTensor>& other);
+
+template <class Tensor>
+void MPOt<Tensor>::
+directSum(const vector<MPOt<Tensor> >& terms)
+    {
+    vector<Parent> pterms;
+    pterms.reserve(terms.size());
+    for(size_t t = 0; t < terms.size(); ++t)
+        pterms.push_back(static_cast<const Parent&>(terms[t]));
+    Parent::directSum(pterms);
+    }
+template
+void MPOt<ITensor>::directSum(const vector<MPOt<ITensor> >& terms);
+template
+void MPOt<IQTensor>::directSum(const vector<MPOt<IQTensor> >& terms);
+
+template <class Tensor>
+MPOt<Tensor>& MPOt<Tensor>::
+operator+=(const MPOt<Tensor>& other)
+    {
+    if(doWrite())
+        Error("operator+= not supported if doWrite(true)");
+
+    if(this->isNull())
         {
-        MPOt<Tensor> other(other_);
-        try { 
-            other.orthogonalize(); 
-            }
-        catch(const ResultIsZero& rz) 
-            { 
-            return *this;
-            }
-        return addNoOrth(other);
+        *this = other;
+        return *this;
         }
+    if(other.isNull()) return *this;
 
-    return addNoOrth(other_);
+    //The compressing sweep of addNoOrth orthogonalizes
+    //the sum, so the terms need not be orthogonal
+    return addNoOrth(other);
     }
 template
 MPOt<ITensor>& MPOt<ITensor>::operator+=(const MPOt<ITensor>& other);
@@ -177,7 +196,7 @@ findCenter(const IQMPO& psi)
     return -1;
     }
 
-void
+bool
 checkQNs(const IQMPO& psi)
     {
     const int N = psi.N();
@@ -248,18 +267,34 @@ checkQNs(const IQMPO& psi)
             Error("Incorrect Arrow in IQMPO");
             }
         }
+    return true;
     }
 
 template <class MPOType>
 void 
 nmultMPO(const MPOType& Aorig, const MPOType& Borig, MPOType& res,Real cut, int maxm)
     {
+    nmultMPO(Aorig,Borig,res,Opt("Cutoff",cut) & Opt("Maxm",maxm));
+    }
+template
+void nmultMPO(const MPO& Aorig, const MPO& Borig, MPO& res,Real cut, int maxm);
+template
+void nmultMPO(const IQMPO& Aorig, const IQMPO& Borig, IQMPO& res,Real cut, int maxm);
+
+template <class MPOType>
+void 
+nmultMPO(const MPOType& Aorig, const MPOType& Borig, MPOType& res,
+         const OptSet& opts)
+    {
     typedef typename MPOType::TensorT Tensor;
     typedef typename MPOType::IndexT IndexT;
     if(Aorig.N() != Borig.N()) Error("nmultMPO(MPOType): Mismatched N");
     int N = Borig.N();
     MPOType A(Aorig), B(Borig);
 
+    const Real cut = opts.getReal("Cutoff",Aorig.cutoff());
+    const int maxm = opts.getInt("Maxm",Aorig.maxm());
+
     SVDWorker svd = A.svd();
     svd.cutoff(cut);
     svd.maxm(maxm);
@@ -274,6 +309,7 @@ nmultMPO(const MPOType& Aorig, const MPOType& Borig, MPOType& res,Real cut, int
 
     Tensor clust,nfork;
     vector<int> midsize(N);
+    Contractor<Tensor> C;
     for(int i = 1; i < N; ++i)
         {
         if(i == 1) 
@@ -282,7 +318,7 @@ nmultMPO(const MPOType& Aorig, const MPOType& Borig, MPOType& res,Real cut, int
             }
         else       
             { 
-            clust = nfork * A.A(i) * B.A(i); 
+            clust = C(nfork,A.A(i),B.A(i)); 
             }
 
         if(i == N-1) break;
@@ -322,13 +358,14 @@ nmultMPO(const MPOType& Aorig, const MPOType& Borig, MPOType& res,Real cut, int
     res.noprimelink();
     res.mapprime(2,1,Site);
     res.cutoff(cut);
+    res.maxm(maxm);
     res.orthogonalize();
 
-    }//void nmultMPO(const MPOType& Aorig, const IQMPO& Borig, IQMPO& res,Real cut, int maxm)
+    }//void nmultMPO(const MPOType& Aorig, const IQMPO& Borig, IQMPO& res, const OptSet& opts)
 template
-void nmultMPO(const MPO& Aorig, const MPO& Borig, MPO& res,Real cut, int maxm);
+void nmultMPO(const MPO& Aorig, const MPO& Borig, MPO& res,const OptSet& opts);
 template
-void nmultMPO(const IQMPO& Aorig, const IQMPO& Borig, IQMPO& res,Real cut, int maxm);
+void nmultMPO(const IQMPO& Aorig, const IQMPO& Borig, IQMPO& res,const OptSet& opts);
 
 
 template <class Tensor>
@@ -452,6 +489,198 @@ void
 exactApplyMPO(const IQMPS& x, const IQMPO& K, IQMPS& res);
 
 
+//
+// Projects |x> + fac*K|psi> onto the two-site block (b,b+1)
+// of the basis of res defined by the environments LK,RK (for 
+// the K|psi> term) and Lx,Rx (for the |x> term)
+//
+template<class Tensor>
+Tensor
+fitPhi(int b, const MPSt<Tensor>* x, Real fac,
+       const MPSt<Tensor>& psi, const MPOt<Tensor>& K,
+       const vector<Tensor>& LK, const vector<Tensor>& RK,
+       const vector<Tensor>& Lx, const vector<Tensor>& Rx)
+    {
+    const int N = psi.N();
+
+    Tensor phi = psi.A(b);
+    if(b > 1) phi *= LK.at(b-1);
+    phi *= K.A(b);
+    phi *= psi.A(b+1);
+    phi *= K.A(b+1);
+    if(b+1 < N) phi *= RK.at(b+2);
+    phi.noprime();
+    phi *= fac;
+
+    if(x != 0)
+        {
+        Tensor phix = x->A(b);
+        if(b > 1) phix *= Lx.at(b-1);
+        phix *= x->A(b+1);
+        if(b+1 < N) phix *= Rx.at(b+2);
+        phix.noprime();
+        phi += phix;
+        }
+
+    return phi;
+    }
+
+//
+// Extends the environment E by one site, contracting the
+// ket site tensor (and MPO tensor op) with the bra tensor
+//
+template<class Tensor>
+void
+extendFitEnv(Tensor& E, const Tensor& ket, const Tensor& bra)
+    {
+    if(E.isNull()) 
+        E = ket;
+    else           
+        E *= ket;
+    E *= bra;
+    }
+
+template<class Tensor>
+void
+extendFitEnv(Tensor& E, const Tensor& ket, const Tensor& op,
+             const Tensor& bra)
+    {
+    if(E.isNull()) 
+        E = ket;
+    else           
+        E *= ket;
+    E *= op;
+    E *= bra;
+    }
+
+template<class Tensor>
+Real
+fitApplyMPOImpl(const MPSt<Tensor>* x, Real fac,
+                const MPSt<Tensor>& psi, const MPOt<Tensor>& K, 
+                MPSt<Tensor>& res, const OptSet& opts)
+    {
+    typedef MPSt<Tensor>
+    MPST;
+
+    const int N = psi.N();
+    if(K.N() != N) Error("Mismatched N in fitApplyMPO");
+    if(x != 0 && x->N() != N) Error("Mismatched N in fitApplyMPO");
+    if(N < 2) Error("fitApplyMPO requires at least 2 sites");
+
+    const int nsweep = opts.getInt("Nsweep",2);
+    const bool verbose = opts.getBool("Verbose",false);
+
+    //Copy inputs since they may be the same object as res
+    //(tensor storage is shared so this is cheap)
+    const MPST psic(psi);
+    MPST xc;
+    if(x != 0) 
+        {
+        xc = *x;
+        x = &xc;
+        }
+
+    if(res.N() != N) res = (x != 0 ? xc : psic);
+
+    res.maxm(opts.getInt("Maxm",res.maxm()));
+    res.cutoff(opts.getReal("Cutoff",res.cutoff()));
+    res.position(1);
+
+    //Environments for the K|psi> and |x> terms.
+    //The bra for the K|psi> term has primed site indices
+    //to match the output of K
+    vector<Tensor> LK(N+2), RK(N+2), 
+                   Lx(N+2), Rx(N+2);
+
+    for(int j = N; j > 2; --j)
+        {
+        RK.at(j) = RK.at(j+1);
+        extendFitEnv(RK.at(j),psic.A(j),K.A(j),conj(primed(res.A(j))));
+        if(x == 0) continue;
+        Rx.at(j) = Rx.at(j+1);
+        extendFitEnv(Rx.at(j),x->A(j),conj(primed(res.A(j),Link)));
+        }
+
+    Real err = 0,
+         lastnrm = -1;
+    for(int sw = 1; sw <= nsweep; ++sw)
+        {
+        Real maxtrunc = 0,
+             nrm = 0;
+        for(int b = 1; b < N; ++b)
+            {
+            Tensor phi = fitPhi(b,x,fac,psic,K,LK,RK,Lx,Rx);
+            res.svdBond(b,phi,Fromleft);
+            maxtrunc = max(maxtrunc,res.svd().truncerr(b));
+
+            if(b == N-1) break;
+
+            LK.at(b) = LK.at(b-1);
+            extendFitEnv(LK.at(b),psic.A(b),K.A(b),conj(primed(res.A(b))));
+            if(x == 0) continue;
+            Lx.at(b) = Lx.at(b-1);
+            extendFitEnv(Lx.at(b),x->A(b),conj(primed(res.A(b),Link)));
+            }
+        for(int b = N-1; b >= 1; --b)
+            {
+            Tensor phi = fitPhi(b,x,fac,psic,K,LK,RK,Lx,Rx);
+            res.svdBond(b,phi,Fromright);
+            maxtrunc = max(maxtrunc,res.svd().truncerr(b));
+            if(b == 1) nrm = phi.norm();
+
+            RK.at(b+1) = RK.at(b+2);
+            extendFitEnv(RK.at(b+1),psic.A(b+1),K.A(b+1),conj(primed(res.A(b+1))));
+            if(x == 0) continue;
+            Rx.at(b+1) = Rx.at(b+2);
+            extendFitEnv(Rx.at(b+1),x->A(b+1),conj(primed(res.A(b+1),Link)));
+            }
+
+        err = maxtrunc;
+        if(lastnrm > 0) err += fabs(1.-sqr(lastnrm/nrm));
+        lastnrm = nrm;
+
+        if(verbose)
+            {
+            cout << format("fitApplyMPO: sweep %d, norm = %.10f, max truncerr = %.3E")
+                    % sw % nrm % maxtrunc << endl;
+            }
+        }
+
+    return err;
+    }
+
+template<class Tensor>
+Real
+fitApplyMPO(const MPSt<Tensor>& psi, const MPOt<Tensor>& K, MPSt<Tensor>& res,
+            const OptSet& opts)
+    {
+    return fitApplyMPOImpl((const MPSt<Tensor>*)0,1.,psi,K,res,opts);
+    }
+template
+Real
+fitApplyMPO(const MPS& psi, const MPO& K, MPS& res, const OptSet& opts);
+template
+Real
+fitApplyMPO(const IQMPS& psi, const IQMPO& K, IQMPS& res, const OptSet& opts);
+
+template<class Tensor>
+Real
+fitApplyMPO(const MPSt<Tensor>& x, Real fac, 
+            const MPSt<Tensor>& psi, const MPOt<Tensor>& K, 
+            MPSt<Tensor>& res, const OptSet& opts)
+    {
+    return fitApplyMPOImpl(&x,fac,psi,K,res,opts);
+    }
+template
+Real
+fitApplyMPO(const MPS& x, Real fac, const MPS& psi, const MPO& K, 
+            MPS& res, const OptSet& opts);
+template
+Real
+fitApplyMPO(const IQMPS& x, Real fac, const IQMPS& psi, const IQMPO& K, 
+            IQMPS& res, const OptSet& opts);
+
+
 template<class Tensor>
 void 
 expsmallH(const MPOt<Tensor>& H, MPOt<Tensor>& K, 
@@ -58,6 +58,9 @@ class MPOt : private MPSt<Tensor>
 
     MPOt(Model& model, std::istream& s) { read(model,s); }
 
+    void
+    swap(MPOt& other) { Parent::swap(other); }
+
     //Accessor Methods ------------------------------
 
     using Parent::N;
@@ -102,8 +105,20 @@ class MPOt : private MPSt<Tensor>
     friend MPOt inline
     operator*(Real r, MPOt res) { res *= r; return res; }
 
+    //
+    // Sums two MPOs by stacking their link indices,
+    // then compresses the result (see orthogonalize).
+    // Neither operand needs to be orthogonalized first,
+    // so repeated += keeps the bond dimension close to
+    // the minimal one for the given cutoff.
+    //
     MPOt&
-    addNoOrth(const MPOt& oth) { Parent::addNoOrth(oth); return *this; }
+    addNoOrth(const MPOt& oth);
+
+    //Replaces this by the direct sum of terms
+    //(link dimensions add), without compressing
+    void
+    directSum(const std::vector<MPOt>& terms);
 
     MPOt& 
     operator+=(const MPOt& oth);
@@ -161,6 +176,16 @@ class MPOt : private MPSt<Tensor>
     void 
     position(int i, const OptSet& opts = Global::opts());
 
+    //
+    // Compresses the MPO by an orthogonalizing
+    // (non-truncating) sweep to the right followed
+    // by a truncating sweep to the left. Exact up to 
+    // the cutoff, cost scales as N k^3.
+    //
+    // Options recognized:
+    //     Cutoff - truncation cutoff (default cutoff())
+    //     Maxm - maximum bond dimension (default maxm())
+    //
     void 
     orthogonalize(const OptSet& opts = Global::opts());
 
@@ -232,10 +257,10 @@ toMPO() const
 int
 findCenter(const IQMPO& psi);
 
-void inline 
-checkQNs(const MPO& psi) { }
+inline bool 
+checkQNs(const MPO& psi) { return true; }
 
-void
+bool
 checkQNs(const IQMPO& psi);
 
 
@@ -348,6 +373,21 @@ psiHKphi(const IQMPS& psi, const IQMPO& H, const IQMPO& K,const IQMPS& phi) //<p
     return re;
     }
 
+//
+// Computes the product res = A*B (B acting first)
+// by zipping up the two MPOs from the left, truncating
+// each new bond as it is made, followed by a compressing
+// sweep (see MPOt::orthogonalize).
+//
+// Options recognized:
+//     Cutoff - truncation cutoff (default A.cutoff())
+//     Maxm - maximum bond dimension (default A.maxm())
+//
+template <class MPOType>
+void 
+nmultMPO(const MPOType& Aorig, const MPOType& Borig, MPOType& res,
+         const OptSet& opts = Global::opts());
+
 template <class MPOType>
 void 
 nmultMPO(const MPOType& Aorig, const MPOType& Borig, MPOType& res,Real cut, int maxm);
@@ -384,6 +424,43 @@ template<class Tensor>
 void 
 exactApplyMPO(const MPSt<Tensor>& x, const MPOt<Tensor>& K, MPSt<Tensor>& res);
 
+//
+// Applies an MPO K to an MPS psi by variationally fitting
+// |res> to K|psi> at the bond dimension of res, avoiding
+// the m*k bond dimension of exactApplyMPO.
+//
+// Sweeps back and forth over two-site blocks, projecting
+// K|psi> onto the current basis of res using cached 
+// left and right overlap environments.
+//
+// If res has the same number of sites as psi, it is used
+// as the starting guess; otherwise psi is used.
+//
+// Options recognized:
+//     Nsweep - number of back and forth sweeps (default 2)
+//     Maxm, Cutoff - truncation settings (defaults are those of res)
+//     Verbose - print the norm and truncation error after each sweep
+//
+// Returns an estimate of the relative error in the fit: the 
+// largest truncation error of the final sweep plus the relative 
+// change of the fitted norm over that sweep.
+//
+template<class Tensor>
+Real
+fitApplyMPO(const MPSt<Tensor>& psi, const MPOt<Tensor>& K, MPSt<Tensor>& res,
+            const OptSet& opts = Global::opts());
+
+//
+// Same as above, but fits |res> to |x> + fac*K|psi>.
+// Any of x, psi, and res may be the same MPS.
+//
+template<class Tensor>
+Real
+fitApplyMPO(const MPSt<Tensor>& x, Real fac, 
+            const MPSt<Tensor>& psi, const MPOt<Tensor>& K, 
+            MPSt<Tensor>& res,
+            const OptSet& opts = Global::opts());
+
 //Computes the exponential of the MPO H: K=exp(-tau*(H-Etot))
 template<class Tensor>
 void 
@@ -140,6 +140,26 @@ operator=(const MPSt<ITensor>&);
 template MPSt<IQTensor>& MPSt<IQTensor>::
 operator=(const MPSt<IQTensor>&);
 
+template <class Tensor>
+void MPSt<Tensor>::
+swap(MPSt& other)
+    {
+    std::swap(N_,other.N_);
+    A_.swap(other.A_);
+    std::swap(l_orth_lim_,other.l_orth_lim_);
+    std::swap(r_orth_lim_,other.r_orth_lim_);
+    std::swap(is_ortho_,other.is_ortho_);
+    std::swap(model_,other.model_);
+    std::swap(svd_,other.svd_);
+    std::swap(atb_,other.atb_);
+    writedir_.swap(other.writedir_);
+    std::swap(do_write_,other.do_write_);
+    }
+template void MPSt<ITensor>::
+swap(MPSt<ITensor>&);
+template void MPSt<IQTensor>::
+swap(MPSt<IQTensor>&);
+
 template <class Tensor>
 MPSt<Tensor>::
 ~MPSt()
@@ -487,6 +507,47 @@ plussers(const IQIndex& l1, const IQIndex& l2, IQIndex& sumind,
         }
     }
 
+void 
+plussers(const vector<Index>& ls, Index& sumind, vector<ITensor>& P)
+    {
+    int m = 0;
+    for(size_t t = 0; t < ls.size(); ++t) m += ls[t].m();
+    sumind = Index(sumind.rawname(),m,sumind.type());
+    P.resize(ls.size());
+    int offset = 0;
+    for(size_t t = 0; t < ls.size(); ++t)
+        {
+        P[t] = ITensor(ls[t],sumind);
+        for(int i = 1; i <= ls[t].m(); ++i) 
+            P[t](ls[t](i),sumind(offset+i)) = 1;
+        offset += ls[t].m();
+        }
+    }
+
+void 
+plussers(const vector<IQIndex>& ls, IQIndex& sumind, vector<IQTensor>& P)
+    {
+    vector<map<Index,Index> > lmap(ls.size());
+    vector<IndexQN> iq;
+    for(size_t t = 0; t < ls.size(); ++t)
+    Foreach(const IndexQN& x, ls[t].indices())
+        {
+        Index jj(x.rawname(),x.m(),x.type());
+        lmap[t][x] = jj;
+        iq.push_back(IndexQN(jj,x.qn));
+        }
+    sumind = IQIndex(sumind.rawname(),iq,sumind.dir(),sumind.primeLevel());
+    P.resize(ls.size());
+    for(size_t t = 0; t < ls.size(); ++t)
+        {
+        P[t] = IQTensor(conj(ls[t]),sumind);
+        Foreach(const Index& il, ls[t].indices())
+            {
+            P[t] += ITensor(il,lmap[t][il],1.0);
+            }
+        }
+    }
+
 //#define NEW_MPS_ADDITION
 
 #ifdef NEW_MPS_ADDITION
@@ -617,6 +678,21 @@ addNoOrth(const MPSt<Tensor>& other_)
     if(do_write_)
         Error("addNoOrth not supported if doWrite(true)");
 
+    directSum(other_);
+
+    orthogonalize();
+
+    return *this;
+    }
+template
+MPSt<ITensor>& MPSt<ITensor>::addNoOrth(const MPSt<ITensor>& other);
+template
+MPSt<IQTensor>& MPSt<IQTensor>::addNoOrth(const MPSt<IQTensor>& other);
+
+template <class Tensor>
+void MPSt<Tensor>::
+directSum(const MPSt<Tensor>& other_)
+    {
     primelinks(0,4);
 
     vector<Tensor> first(N_), second(N_);
@@ -638,14 +714,63 @@ addNoOrth(const MPSt<Tensor>& other_)
 
     noprimelink();
 
-    orthogonalize();
+    l_orth_lim_ = 0;
+    r_orth_lim_ = N_+1;
+    is_ortho_ = false;
+    }
+template
+void MPSt<ITensor>::directSum(const MPSt<ITensor>& other);
+template
+void MPSt<IQTensor>::directSum(const MPSt<IQTensor>& other);
 
-    return *this;
+template <class Tensor>
+void MPSt<Tensor>::
+directSum(const vector<MPSt<Tensor> >& terms)
+    {
+    if(do_write_)
+        Error("directSum not supported if doWrite(true)");
+
+    const int Nt = terms.size();
+    if(Nt == 0) Error("directSum: no terms");
+    for(int t = 0; t < Nt; ++t)
+        {
+        if(terms[t].N() != N_) Error("directSum: mismatched N");
+        }
+
+    //P[i][t] maps link i of term t into
+    //the corresponding block of the new link i
+    vector<vector<Tensor> > P(N_);
+    for(int i = 1; i < N_; ++i)
+        {
+        vector<IndexT> ls(Nt);
+        for(int t = 0; t < Nt; ++t)
+            ls[t] = terms[t].RightLinkInd(i);
+        IndexT r(ls.front());
+        plussers(ls,r,P[i]);
+        }
+
+    for(int i = 1; i <= N_; ++i)
+        {
+        Tensor S;
+        for(int t = 0; t < Nt; ++t)
+            {
+            Tensor At = terms[t].A(i);
+            if(i > 1) At = conj(P[i-1][t]) * At;
+            if(i < N_) At *= P[i][t];
+            if(t == 0) S = At;
+            else       S += At;
+            }
+        Anc(i) = S;
+        }
+
+    l_orth_lim_ = 0;
+    r_orth_lim_ = N_+1;
+    is_ortho_ = false;
     }
 template
-MPSt<ITensor>& MPSt<ITensor>::addNoOrth(const MPSt<ITensor>& other);
+void MPSt<ITensor>::directSum(const vector<MPSt<ITensor> >& terms);
 template
-MPSt<IQTensor>& MPSt<IQTensor>::addNoOrth(const MPSt<IQTensor>& other);
+void MPSt<IQTensor>::directSum(const vector<MPSt<IQTensor> >& terms);
 
 
 //
@@ -930,20 +1055,6 @@ void MPSt<ITensor>::cleanupWrite();
 template
 void MPSt<IQTensor>::cleanupWrite();
 
-//Auxilary method for convertToIQ
-int 
-collapseCols(const Vector& Diag, Matrix& M)
-    {
-    int nr = Diag.Length(), nc = int(Diag.sumels());
-    assert(nr != 0);
-    if(nc == 0) return nc;
-    M = Matrix(nr,nc); M = 0;
-    int c = 0;
-    for(int r = 1; r <= nr; ++r)
-    if(Diag(r) == 1) { M(r,++c) = 1; }
-    return nc;
-    }
-
 int 
 periodicWrap(int j, int N)
     {
@@ -955,6 +1066,52 @@ periodicWrap(int j, int N)
     return j;
     }
 
+//
+// Auxilary struct for convertToIQ:
+// a QN sector of a link IQIndex, spanning
+// the dense link states listed in rows
+//
+struct LinkSector
+    {
+    QN q;
+    Index ind;
+    vector<int> rows;
+    };
+
+//
+// Auxilary struct for convertToIQ:
+// a non-zero block of a site tensor, connecting
+// left sector k to right sector r through 
+// site state n (and site' state u for an MPO)
+//
+struct SiteBlock
+    {
+    int k, n, u, r;
+    };
+
+//
+// Auxilary struct for convertToIQ:
+// dense data of a site tensor, ordered as
+// (left,site,site',right) with left fastest
+//
+struct DenseSite
+    {
+    int s, ml, d, pd, mr;
+    bool cplx;
+    Vector re, im;
+
+    int
+    offset(int a, int n, int u, int b) const
+        { return a + ml*((n-1) + d*((u-1) + pd*(b-1))); }
+
+    Real
+    absval(int a, int n, int u, int b) const
+        { 
+        const int o = offset(a,n,u,b);
+        return (cplx ? sqrt(sqr(re(o))+sqr(im(o))) : fabs(re(o)));
+        }
+    };
+
 void 
 convertToIQ(const Model& model, const vector<ITensor>& A, 
             vector<IQTensor>& qA, QN totalq, Real cut)
@@ -962,10 +1119,6 @@ convertToIQ(const Model& model, const vector<ITensor>& A,
     const int N = A.size()-1;
     qA.resize(A.size());
     const bool is_mpo = hasindex(A[1],model.siP(1));
-    const int Dim = model.si(1).m();
-    if(model.si(2).m() != Dim)
-        Error("convertToIQ assumes uniform site dimension");
-    const int PDim = (is_mpo ? Dim : 1);
 
     // If MPO, set all tensors to identity ops initially
     if(is_mpo)
@@ -982,7 +1135,6 @@ convertToIQ(const Model& model, const vector<ITensor>& A,
             if(A.at(periodicWrap(j-1,N)).r() < fullrank) 
                 {
                 start = periodicWrap(j-1,N);
-                //cerr << "Got start at " << start << "\n";
                 break;
                 }
 
@@ -991,231 +1143,234 @@ convertToIQ(const Model& model, const vector<ITensor>& A,
             if(A.at(periodicWrap(j+1,N)).r() < fullrank) 
                 {
                 end = periodicWrap(j+1,N);
-                //cerr << "Got end at " << end << "\n";
                 break;
                 }
 
-    //cout << "Converting to IQ with (start, end) = " << start SP end << endl;
-
-    vector<IQIndex> linkind(N+1);
-
-    typedef map<QN,Vector>::value_type qD_vt;
-    map<QN,Vector> qD; //Diags of compressor matrices by QN
-
-    typedef map<QN,vector<ITensor> >::value_type qt_vt;
-    map<QN,vector<ITensor> > qt; //ITensor blocks by QN
-
-    typedef map<QN,ITensor>::value_type qC_vt;
-    map<QN,ITensor> qC; //Compressor ITensors by QN
+    const int Send = (end < start ? N+end : end); 
+    const int Ns = Send-start+1;
 
-    ITensor block;
-    vector<ITensor> nblock;
-    vector<IndexQN> iq;
-
-    QN q;
-
-    qC[totalq] = ITensor(); //Represents Virtual index
-    //First value of prev_q below set to totalq
-
-    const int show_s = 0;
-
-    Index bond, prev_bond;
-    int Send = (end < start ? N+end : end); 
-    for(int S = start; S <= Send; ++S)
+    //
+    // 1. Extract the dense data of every site tensor
+    //    in a fixed index order (independent, so
+    //    done in parallel)
+    //
+    vector<DenseSite> dense(Ns);
+    vector<Index> bond(Ns);
+    for(int S = start; S < Send; ++S)
         {
-        int s = periodicWrap(S,N);
-        int sprev = periodicWrap(S-1,N);
-        int snext = periodicWrap(S+1,N);
-        //cerr << format("S = %d, s = %d, sprev = %d, snext = %d\n")%S%s%sprev%snext;
+        bond.at(S-start) = commonIndex(A[periodicWrap(S,N)],
+                                       A[periodicWrap(S+1,N)],Link);
+        }
 
-        qD.clear(); 
-        qt.clear();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for(int j = 0; j < Ns; ++j)
+        {
+        const int S = start+j;
+        DenseSite& D = dense[j];
+        D.s = periodicWrap(S,N);
+        const Index si = Index(model.si(D.s)),
+                    siP = Index(model.siP(D.s));
+        D.ml = (S == start ? 1 : bond.at(j-1).m());
+        D.d = si.m();
+        D.pd = (is_mpo ? siP.m() : 1);
+        D.mr = (S == Send ? 1 : bond.at(j).m());
+        D.cplx = isComplex(A[D.s]);
+
+        IndexSet<Index> order;
+        if(S != start) order.addindex(bond.at(j-1));
+        order.addindex(si);
+        if(is_mpo) order.addindex(siP);
+        if(S != Send) order.addindex(bond.at(j));
+
+        ITensor T(order,Vector(D.ml*D.d*D.pd*D.mr,0));
+        T += (D.cplx ? realPart(A[D.s]) : A[D.s]);
+        D.re.ReDimension(T.vecSize());
+        T.assignToVec(D.re);
+        if(D.cplx)
+            {
+            ITensor Ti(order,Vector(D.ml*D.d*D.pd*D.mr,0));
+            Ti += imagPart(A[D.s]);
+            D.im.ReDimension(Ti.vecSize());
+            Ti.assignToVec(D.im);
+            }
+        }
 
-        if(S > start) prev_bond = commonIndex(A[sprev],A[s],Link);
-        if(S < Send) bond = commonIndex(A[s],A[snext],Link);
+    //
+    // 2. Sweep through the sites, classifying each
+    //    (left sector, site state) block by QN and 
+    //    finding which right link states it reaches
+    //
+    vector<vector<LinkSector> > sectors(Ns+1);
+    vector<vector<SiteBlock> > blocks(Ns);
 
-        if(s == show_s) { PrintDat(A[s]); }
+    //Sectors to the left of the first site:
+    //a single virtual state with QN totalq
+    sectors.at(0).resize(1);
+    sectors.at(0).front().q = totalq;
+    sectors.at(0).front().rows.assign(1,1);
 
-        Foreach(const qC_vt& x, qC) 
-        for(int n = 1; n <= Dim;  ++n)
-        for(int u = 1; u <= PDim; ++u)
+    for(int j = 0; j < Ns; ++j)
+        {
+        const int S = start+j;
+        const DenseSite& D = dense[j];
+        const IQIndex& si = model.si(D.s);
+        const vector<LinkSector>& lsec = sectors.at(j);
+
+        map<QN,vector<char> > keep;
+        map<QN,vector<SiteBlock> > qblocks;
+        vector<Real> colmax(D.mr);
+
+        for(size_t k = 0; k < lsec.size(); ++k)
+        for(int n = 1; n <= D.d;  ++n)
+        for(int u = 1; u <= D.pd; ++u)
             {
-            //Each compressor represents a particular
-            //QN channel given by prev_q
-            const QN& prev_q = x.first; 
-            //Alias previous compressor ITensor to comp
-            const ITensor& comp = x.second; 
-
-            q = (is_mpo ? prev_q+model.si(s).qn(n)-model.si(s).qn(u) 
-                        : prev_q-model.si(s).qn(n));
+            const QN q = (is_mpo ? lsec[k].q+si.qn(n)-si.qn(u) 
+                                 : lsec[k].q-si.qn(n));
 
             //For the last site, only keep blocks 
             //compatible with specified totalq i.e. q=0 here
             if(S == Send && q != QN()) continue;
 
-            //Set Site indices of A[s] and its previous Link Index
-            block = A[s];
-            if(S != start) block *= conj(comp);
-            block *= Index(model.si(s))(n);
-            if(is_mpo) block *= Index(model.siP(s))(u);
-
-            //Initialize D Vector (D records which values of
-            //the right Link Index to keep for the current QN q)
-            int count = qD.count(q);
-            Vector& D = qD[q];
-            if(count == 0) { D.ReDimension(bond.m()); D = 0; }
-
-            if(s == show_s)
+            //Largest element reaching each right link state
+            Real maxel = 0;
+            for(int b = 1; b <= D.mr; ++b)
                 {
-                cerr << boost::format("For n = %d\n")%n;
-                cerr << boost::format("Got a block with norm %.10f\n")%block.norm();
-                cerr << boost::format("bond.m() = %d\n")%bond.m();
-                PrintDat(block);
-                if(s != 1) PrintDat(comp);
+                Real& cm = colmax[b-1];
+                cm = 0;
+                Foreach(int a, lsec[k].rows)
+                    cm = max(cm,D.absval(a,n,u,b));
+                maxel = max(maxel,cm);
                 }
+            if(maxel == 0) continue;
 
-            bool keep_block = false;
-            if(S == Send) 
-                { keep_block = true; }
-            else
-                {
-                if(bond.m() == 1 && block.norm() != 0) 
-                    { D = 1; keep_block = true; }
-                else
-                    {
-                    ITensor summed_block;
-                    if(S==start) 
-                        { summed_block = block; }
-                    else
-                        {
-                        //Here we sum over the previous link index
-                        //which is already ok, analyze the one to the right
-                        assert(comp.r()==2);
-                        IndexSet<Index>::const_iterator ci = comp.indices().begin();
-                        const Index& new_ind = (*ci==prev_bond ? *(ci+1) : *ci);
-                        summed_block = ITensor(new_ind,1) * block;
-                        }
-                    //cerr << boost::format("s = %d, bond=")%s << bond << "\n";
-                    //summed_block.print("summed_block");
-
-                    Real rel_cut = -1;
-                    const ITensor& sb = summed_block;
-                    for(int j = 1; j <= bond.m(); ++j)
-                        { rel_cut = max(fabs(sb(bond(j))),rel_cut); }
-                    assert(rel_cut >= 0);
-                    //Real rel_cut = summed_block.norm()/summed_block.vecSize();
-                    rel_cut *= cut;
-                    //cerr << "rel_cut == " << rel_cut << "\n";
-
-                    if(rel_cut > 0)
-                    for(int j = 1; j <= bond.m(); ++j)
-                        {
-                        if(fabs(sb(bond(j))) > rel_cut) 
-                            { 
-                            D(j) = 1; 
-                            keep_block = true; 
-                            }
-                        }
-                    }
-                } //else (S != Send)
-
-            if(keep_block)
+            vector<char>& kq = keep[q];
+            if(kq.empty()) kq.assign(D.mr,0);
+            const Real rel_cut = (S == Send || D.mr == 1 ? 0 : maxel*cut);
+            for(int b = 1; b <= D.mr; ++b)
                 {
-                qD[q] = D;
-
-                IndexSet<Index> newinds(block.indices());
-                if(is_mpo) 
-                    {
-                    newinds.addindex(conj(model.si(s)(n).indexqn()));
-                    newinds.addindex(model.siP(s)(u).indexqn());
-                    }
-                else 
-                    { newinds.addindex(model.si(s)(n).indexqn()); }
-
-                qt[q].push_back(ITensor(newinds,block));
-
-                if(s==show_s)
-                    {
-                    PrintDat(block);
-                    cerr << "D = " << D << "\n";
-                    }
+                if(colmax[b-1] > rel_cut) kq[b-1] = 1;
                 }
-            }
 
-        qC.clear();
+            SiteBlock B;
+            B.k = k; B.n = n; B.u = u; B.r = 0;
+            qblocks[q].push_back(B);
+            }
 
-        Foreach(const qt_vt& x, qt)
+        vector<LinkSector>& rsec = sectors.at(j+1);
+        for(map<QN,vector<char> >::const_iterator it = keep.begin();
+            it != keep.end(); ++it)
             {
-            const vector<ITensor>& blks = x.second;
-            if(blks.size() != 0)
+            const QN& q = it->first;
+            LinkSector sec;
+            sec.q = q;
+            for(int b = 1; b <= D.mr; ++b)
+                if(it->second[b-1]) sec.rows.push_back(b);
+            if(S != Send)
                 {
-                q = x.first; 
-                if(S == Send) 
-                    { Foreach(const ITensor& t, blks) nblock.push_back(t); }
-                else
-                    {
-                    Matrix M; 
-                    int mm = collapseCols(qD[q],M);
-                    if(s==show_s)
-                        {
-                        cerr << boost::format("Adding block, mm = %d\n")%mm;
-                        Print(q);
-                        cerr << "qD[q] = " << qD[q] << "\n";
-                        cerr << "M = \n" << M << "\n";
-                        int count = 0;
-                        Foreach(const ITensor& t, blks) 
-                            {
-                            cout << format("t%02d") % (++count) << t << endl;
-                            }
-                        }
-                    //string qname = (boost::format("ql%d(%+d:%d:%s)")%s%q.sz()%q.Nf()%(q.Nfp() == 0 ? "+" : "-")).str();
-                    string qname = (boost::format("ql%d(%+d:%d)")%s%q.sz()%q.Nf()).str();
-                    Index qbond(qname,mm);
-                    ITensor compressor(bond,qbond,M);
-                    Foreach(const ITensor& t, blks) nblock.push_back(t * compressor);
-                    iq.push_back(IndexQN(qbond,q));
-                    qC[q] = compressor;
-                    }
+                string qname = (boost::format("ql%d(%+d:%d)")%D.s%q.sz()%q.Nf()).str();
+                sec.ind = Index(qname,sec.rows.size());
                 }
-            }
-
-        if(S != Send) 
-            { 
-            if(iq.empty()) 
+            Foreach(SiteBlock B, qblocks[q])
                 {
-                cerr << "At site " << s << "\n";
-                Error("convertToIQ: no compatible QNs to put into Link.");
+                B.r = rsec.size();
+                blocks.at(j).push_back(B);
                 }
-            linkind[s] = IQIndex(nameint("qL",s),iq); iq.clear(); 
+            rsec.push_back(sec);
             }
+
+        if(S != Send && rsec.empty())
+            {
+            cerr << "At site " << D.s << "\n";
+            Error("convertToIQ: no compatible QNs to put into Link.");
+            }
+        }
+
+    vector<IQIndex> linkind(Ns);
+    for(int j = 0; j < Ns-1; ++j)
+        {
+        vector<IndexQN> iq;
+        Foreach(const LinkSector& sec, sectors.at(j+1))
+            iq.push_back(IndexQN(sec.ind,sec.q));
+        linkind.at(j) = IQIndex(nameint("qL",dense[j].s),iq);
+        }
+
+    //
+    // 3. Fill in the IQTensor blocks, copying the
+    //    dense elements of each block directly
+    //    (independent, so done in parallel)
+    //
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for(int j = 0; j < Ns; ++j)
+        {
+        const int S = start+j;
+        const DenseSite& D = dense[j];
+        const int s = D.s;
+        const IQIndex& si = model.si(s);
+        const IQIndex siP = model.siP(s);
+
+        IQTensor T;
         if(S == start)
             {
-            qA.at(s) = (is_mpo ? IQTensor(conj(model.si(s)),model.siP(s),linkind.at(s)) 
-                            : IQTensor(model.si(s),linkind[s]));
+            T = (is_mpo ? IQTensor(conj(si),siP,linkind.at(j)) 
+                        : IQTensor(si,linkind.at(j)));
             }
         else 
         if(S == Send)
             {
-            qA.at(s) = (is_mpo ? IQTensor(conj(linkind[sprev]),conj(model.si(s)),model.siP(s)) 
-                            : IQTensor(conj(linkind[sprev]),model.si(s)));
+            T = (is_mpo ? IQTensor(conj(linkind.at(j-1)),conj(si),siP) 
+                        : IQTensor(conj(linkind.at(j-1)),si));
             }
         else
             {
-            qA.at(s) = (is_mpo ? IQTensor(conj(linkind[sprev]),conj(model.si(s)),model.siP(s),linkind[s]) 
-                            : IQTensor(conj(linkind[sprev]),model.si(s),linkind[s]));
+            T = (is_mpo ? IQTensor(conj(linkind.at(j-1)),conj(si),siP,linkind.at(j)) 
+                        : IQTensor(conj(linkind.at(j-1)),si,linkind.at(j)));
             }
 
-        Foreach(const ITensor& nb, nblock) 
-            { qA.at(s) += nb; } 
-        nblock.clear();
-
-        if(s==show_s)
+        Foreach(const SiteBlock& B, blocks.at(j))
             {
-            cout << format("qA[%d]")%s << qA[s] << endl;
-            Error("Stopping");
+            const LinkSector& L = sectors.at(j)[B.k];
+            const LinkSector& R = sectors.at(j+1)[B.r];
+            const int mk = L.rows.size(),
+                      mq = R.rows.size();
+
+            IndexSet<Index> inds;
+            if(S != start) inds.addindex(L.ind);
+            if(S != Send) inds.addindex(R.ind);
+            if(is_mpo) 
+                {
+                inds.addindex(conj(si(B.n).indexqn()));
+                inds.addindex(siP(B.u).indexqn());
+                }
+            else 
+                { 
+                inds.addindex(si(B.n).indexqn()); 
+                }
+
+            Vector bre(mk*mq), bim;
+            if(D.cplx) bim.ReDimension(mk*mq);
+            for(int c = 0; c < mq; ++c)
+            for(int a = 0; a < mk; ++a)
+                {
+                const int o = D.offset(L.rows[a],B.n,B.u,R.rows[c]);
+                bre(1+a+mk*c) = D.re(o);
+                if(D.cplx) bim(1+a+mk*c) = D.im(o);
+                }
+
+            ITensor blk(inds,bre);
+            if(D.cplx)
+                {
+                blk *= ITensor::Complex_1();
+                blk += ITensor(inds,bim) * ITensor::Complex_i();
+                }
+            T += blk;
             }
 
-        } //for loop over s
+        qA.at(s) = T;
+        }
 
     } //void convertToIQ
 
@@ -63,6 +63,13 @@ class MPSt
 
     ~MPSt();
 
+    //Exchanges the contents of this MPS and other;
+    //cheaper than operator= when other is a temporary
+    //since no site tensors are copied (and any write
+    //directory is handed over rather than copied)
+    void
+    swap(MPSt& other);
+
     //
     //MPSt Typedefs
     //
@@ -248,6 +255,13 @@ class MPSt
     MPSt& 
     addNoOrth(const MPSt& oth);
 
+    //Replaces this by the direct sum of terms
+    //(link dimensions add), without orthogonalizing.
+    //Site tensors are block diagonal in the links
+    //so all terms are summed in a single pass.
+    void
+    directSum(const std::vector<MPSt>& terms);
+
     inline MPSt 
     operator+(MPSt res) const { res += *this; return res; }
 
@@ -489,6 +503,11 @@ class MPSt
     void 
     init_tensors(std::vector<IQTensor>& A_, const InitState& initState);
 
+    //Replaces this by the direct sum of this and other
+    //(link dimensions add); does not orthogonalize
+    void
+    directSum(const MPSt& other);
+
     private:
 
     friend class MPSt<ITensor>;
@@ -715,9 +734,10 @@ psiphi(const MPSType& psi, const MPSType& phi, Real& re, Real& im)
 
     for(int i = 2; i < N; ++i) 
         { 
-        L = L * phi.A(i) * conj(primed(psi.A(i),Link)); 
+        L *= phi.A(i); 
+        L *= conj(primed(psi.A(i),Link)); 
         }
-    L = L * phi.A(N);
+    L *= phi.A(N);
 
     BraKet(primed(psi.A(N),psi.LinkInd(N-1)),L,re,im);
     }
@@ -745,6 +765,10 @@ fitWF(const IQMPS& psi_basis, IQMPS& psi_to_fit);
 // Performs the sum in a tree-like fashion in an attempt to
 // leave the largest summands for the last few steps
 //
+// The pairwise sums at each level of the tree are
+// independent and are done in parallel if OpenMP
+// is enabled.
+//
 // Assumes terms are zero-indexed
 //
 template <typename MPSType>
@@ -772,15 +796,47 @@ sum(const std::vector<MPSType>& terms, MPSType& res,
     if(Nt > 2)
         {
         //Add all MPS's in pairs
-        const int nsize = (Nt%2==0 ? Nt/2 : (Nt-1)/2+1);
-        std::vector<MPSType> tpair(2), 
-                             newterms(nsize); 
-        for(int n = 0, np = 0; n < Nt-1; n += 2, ++np)
+        const int nsize = (Nt%2==0 ? Nt/2 : (Nt-1)/2+1),
+                  npair = Nt/2;
+        std::vector<MPSType> newterms(nsize); 
+#ifdef _OPENMP
+        //Exceptions cannot leave a parallel region, so
+        //ITErrors are stored (failed = 1, or 2 for a 
+        //ResultIsZero) and the first is rethrown after it
+        std::vector<int> failed(npair,0);
+        std::vector<std::string> message(npair);
+#pragma omp parallel for schedule(dynamic)
+        for(int np = 0; np < npair; ++np)
+            {
+            std::vector<MPSType> tpair(2);
+            tpair[0] = terms.at(2*np); 
+            tpair[1] = terms.at(2*np+1);
+            try { sum(tpair,newterms.at(np),cut,maxm); }
+            catch(const ResultIsZero& e) 
+                { 
+                failed.at(np) = 2; 
+                message.at(np) = e.what(); 
+                }
+            catch(const ITError& e) 
+                { 
+                failed.at(np) = 1; 
+                message.at(np) = e.what(); 
+                }
+            }
+        for(int np = 0; np < npair; ++np)
+            {
+            if(failed.at(np) == 2) throw ResultIsZero(message.at(np));
+            if(failed.at(np) == 1) throw ITError(message.at(np));
+            }
+#else
+        for(int np = 0; np < npair; ++np)
             {
-            tpair[0] = terms.at(n); 
-            tpair[1] = terms.at(n+1);
+            std::vector<MPSType> tpair(2);
+            tpair[0] = terms.at(2*np); 
+            tpair[1] = terms.at(2*np+1);
             sum(tpair,newterms.at(np),cut,maxm);
             }
+#endif
         if(Nt%2 == 1) newterms.at(nsize-1) = terms.back();
 
         //Recursively call sum again
@@ -788,6 +844,32 @@ sum(const std::vector<MPSType>& terms, MPSType& res,
         }
     }
 
+//
+// Sums a set of MPS's or MPO's by forming the direct sum
+// of all terms at once, then compressing the result with
+// a single call to orthogonalize.
+//
+// Cheaper than the tree sum above when the number of 
+// terms is modest, since only one compressing sweep is
+// needed. The intermediate bond dimension is however the
+// sum of the bond dimensions of all terms.
+//
+// Assumes terms are zero-indexed
+//
+template <typename MPSType>
+void 
+directSum(const std::vector<MPSType>& terms, MPSType& res, 
+          Real cut = MIN_CUT, int maxm = MAX_M)
+    {
+    if(terms.empty()) Error("directSum: no terms");
+    res = terms.front();
+    res.cutoff(cut); 
+    res.maxm(maxm);
+    if(terms.size() == 1) return;
+    res.directSum(terms);
+    res.orthogonalize();
+    }
+
 template <class Tensor>
 std::ostream& 
 operator<<(std::ostream& s, const MPSt<Tensor>& M)
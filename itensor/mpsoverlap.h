@@ -0,0 +1,465 @@
+//
+// Distributed under the ITensor Library License, Version 1.0.
+//    (See accompanying LICENSE file.)
+//
+#ifndef __ITENSOR_MPSOVERLAP
+#define __ITENSOR_MPSOVERLAP
+#include "mpo.h"
+
+//
+// The MPSOverlap class computes overlaps <psi|phi>,
+// matrix elements <psi|H|phi> of an MPO H, and
+// matrix elements of products of site operators,
+// caching the left and right transfer environments
+// so that they are reused across queries.
+//
+//   .-psi1*-psi2*-..-psij*-..-psiN*-.
+//   |   |     |        |        |   |
+//   |   |     |       [Op]      |   |
+//   |   |     |        |        |   |
+//   '-phi1--phi2--..--phij--..-phiN-'
+//
+//   \__________/               \____/
+//      L(j-1)                  R(j+1)
+//
+// Each environment is grown one site at a time in the
+// order L*phi(j) [*Op or *H(j)] *conj(psi(j)), which keeps
+// intermediate tensors at rank 3 (rank 4 with an MPO)
+// and costs m^3 d per site.
+//
+// The MPS (and MPO) passed to the constructor must
+// remain valid and unchanged while the MPSOverlap is used.
+//
+
+template <class Tensor>
+class MPSOverlap
+    {
+    public:
+
+    //
+    // Constructors
+    //
+
+    MPSOverlap(const MPSt<Tensor>& psi, const MPSt<Tensor>& phi);
+
+    MPSOverlap(const MPSt<Tensor>& psi, const MPOt<Tensor>& H,
+               const MPSt<Tensor>& phi);
+
+    int
+    N() const { return N_; }
+
+    //
+    // <psi|phi> or <psi|H|phi>
+    //
+
+    void
+    value(Real& re, Real& im);
+
+    Real
+    value();
+
+    //
+    // <psi|Op|phi> where Op is an operator on site i
+    // (not available if an MPO was provided)
+    //
+
+    void
+    expect(int i, const Tensor& Op, Real& re, Real& im);
+
+    Real
+    expect(int i, const Tensor& Op);
+
+    //
+    // Computes all two-point functions
+    //
+    //     C(i,j) = <psi| A(i) B(j) |phi>
+    //
+    // in a single O(N^2) pass. A and B are indexed from 1 to N;
+    // if A.at(i) or B.at(j) is null the corresponding entries
+    // of C are set to zero. On the diagonal the product A(i)B(i)
+    // is used, with B(i) acting first.
+    //
+
+    void
+    correlations(const std::vector<Tensor>& A,
+                 const std::vector<Tensor>& B,
+                 Matrix& Cre, Matrix& Cim);
+
+    void
+    correlations(const std::vector<Tensor>& A,
+                 const std::vector<Tensor>& B,
+                 Matrix& C);
+
+    //
+    // Same as above, but treating A and B as fermionic
+    // operators: the Jordan-Wigner string operators F
+    // (also indexed from 1 to N) are inserted between
+    // sites i and j, and entries with i > j pick up
+    // the sign from anticommuting A(i) past B(j).
+    //
+    // The rows of C are computed in parallel when 
+    // compiled with OpenMP.
+    //
+
+    void
+    correlations(const std::vector<Tensor>& A,
+                 const std::vector<Tensor>& B,
+                 const std::vector<Tensor>& F,
+                 Matrix& Cre, Matrix& Cim);
+
+    //
+    // Environment of sites 1,2,...,i (L)
+    // and i,i+1,...,N (R). L(0) and R(N+1)
+    // are null.
+    //
+
+    const Tensor&
+    L(int i);
+
+    const Tensor&
+    R(int i);
+
+    private:
+
+    /////////////////
+    //
+    // Data Members
+    //
+
+    const MPSt<Tensor>* psi_;
+    const MPSt<Tensor>* phi_;
+    const MPOt<Tensor>* H_;
+    int N_;
+
+    std::vector<Tensor> L_,
+                        R_;
+    int Lmax_, //L_[j] computed for all j <= Lmax_
+        Rmin_; //R_[j] computed for all j >= Rmin_
+
+    //
+    /////////////////
+
+    void
+    init();
+
+    Tensor
+    bra(int j, bool prime_site) const;
+
+    void
+    applySite(Tensor& E, int j) const;
+
+    void
+    applyOp(Tensor& E, int j, const Tensor& Op) const;
+
+    void
+    close(Tensor E, int i, Real& re, Real& im) const;
+
+    void
+    correlationRow(int i, 
+                   const std::vector<Tensor>& A,
+                   const std::vector<Tensor>& B,
+                   const std::vector<Tensor>* F,
+                   Matrix& Cre, Matrix& Cim) const;
+
+    void
+    checkNoMPO() const
+        {
+        if(H_ != 0) Error("MPSOverlap: operator insertion not available with an MPO");
+        }
+
+    };
+
+template <class Tensor>
+inline MPSOverlap<Tensor>::
+MPSOverlap(const MPSt<Tensor>& psi, const MPSt<Tensor>& phi)
+    :
+    psi_(&psi),
+    phi_(&phi),
+    H_(0),
+    N_(psi.N())
+    {
+    init();
+    }
+
+template <class Tensor>
+inline MPSOverlap<Tensor>::
+MPSOverlap(const MPSt<Tensor>& psi, const MPOt<Tensor>& H,
+           const MPSt<Tensor>& phi)
+    :
+    psi_(&psi),
+    phi_(&phi),
+    H_(&H),
+    N_(psi.N())
+    {
+    if(H.N() != N_) Error("MPSOverlap: mismatched N");
+    init();
+    }
+
+template <class Tensor>
+void inline MPSOverlap<Tensor>::
+init()
+    {
+    if(phi_->N() != N_) Error("MPSOverlap: mismatched N");
+    L_.assign(N_+2,Tensor());
+    R_.assign(N_+2,Tensor());
+    Lmax_ = 0;
+    Rmin_ = N_+1;
+    }
+
+template <class Tensor>
+Tensor inline MPSOverlap<Tensor>::
+bra(int j, bool prime_site) const
+    {
+    if(prime_site) return conj(primed(psi_->A(j)));
+    return conj(primed(psi_->A(j),Link));
+    }
+
+template <class Tensor>
+void inline MPSOverlap<Tensor>::
+applySite(Tensor& E, int j) const
+    {
+    if(E.isNull())
+        E = phi_->A(j);
+    else
+        E *= phi_->A(j);
+
+    if(H_ != 0)
+        {
+        E *= H_->A(j);
+        E *= bra(j,true);
+        }
+    else
+        {
+        E *= bra(j,false);
+        }
+    }
+
+template <class Tensor>
+void inline MPSOverlap<Tensor>::
+applyOp(Tensor& E, int j, const Tensor& Op) const
+    {
+    if(E.isNull())
+        E = phi_->A(j);
+    else
+        E *= phi_->A(j);
+    E *= Op;
+    E *= bra(j,true);
+    }
+
+template <class Tensor>
+const Tensor inline& MPSOverlap<Tensor>::
+L(int i)
+    {
+    while(Lmax_ < i)
+        {
+        ++Lmax_;
+        L_.at(Lmax_) = L_.at(Lmax_-1);
+        applySite(L_.at(Lmax_),Lmax_);
+        }
+    return L_.at(i);
+    }
+
+template <class Tensor>
+const Tensor inline& MPSOverlap<Tensor>::
+R(int i)
+    {
+    while(Rmin_ > i)
+        {
+        --Rmin_;
+        R_.at(Rmin_) = R_.at(Rmin_+1);
+        applySite(R_.at(Rmin_),Rmin_);
+        }
+    return R_.at(i);
+    }
+
+//
+// Contracts E (which includes sites 1...i)
+// with R(i+1), giving a scalar.
+// R(i+1) must already have been computed.
+//
+template <class Tensor>
+void inline MPSOverlap<Tensor>::
+close(Tensor E, int i, Real& re, Real& im) const
+    {
+    if(i < N_) 
+        {
+        if(Rmin_ > i+1) Error("MPSOverlap: R environment not computed");
+        E *= R_.at(i+1);
+        }
+    E.toComplex(re,im);
+    }
+
+template <class Tensor>
+void inline MPSOverlap<Tensor>::
+value(Real& re, Real& im)
+    {
+    //Use whichever environment is already
+    //closest to covering the whole system
+    if(Lmax_ >= N_-Rmin_+1)
+        {
+        L(N_).toComplex(re,im);
+        }
+    else
+        {
+        R(1).toComplex(re,im);
+        }
+    }
+
+template <class Tensor>
+Real inline MPSOverlap<Tensor>::
+value()
+    {
+    Real re, im;
+    value(re,im);
+    if(fabs(im) > 1.0e-12 * fabs(re))
+        std::cerr << "Real MPSOverlap::value: WARNING, dropping non-zero imaginary part.\n";
+    return re;
+    }
+
+template <class Tensor>
+void inline MPSOverlap<Tensor>::
+expect(int i, const Tensor& Op, Real& re, Real& im)
+    {
+    checkNoMPO();
+    Tensor E = L(i-1);
+    applyOp(E,i,Op);
+    R(i+1);
+    close(E,i,re,im);
+    }
+
+template <class Tensor>
+Real inline MPSOverlap<Tensor>::
+expect(int i, const Tensor& Op)
+    {
+    Real re, im;
+    expect(i,Op,re,im);
+    if(fabs(im) > 1.0e-12 * fabs(re))
+        std::cerr << "Real MPSOverlap::expect: WARNING, dropping non-zero imaginary part.\n";
+    return re;
+    }
+
+template <class Tensor>
+void inline MPSOverlap<Tensor>::
+correlationRow(int i, 
+               const std::vector<Tensor>& A,
+               const std::vector<Tensor>& B,
+               const std::vector<Tensor>* F,
+               Matrix& Cre, Matrix& Cim) const
+    {
+    Real re, im;
+    if(!A.at(i).isNull() && !B.at(i).isNull())
+        {
+        Tensor E = L_.at(i-1);
+        applyOp(E,i,multSiteOps(A.at(i),B.at(i)));
+        close(E,i,re,im);
+        Cre(i,i) = re;
+        Cim(i,i) = im;
+        }
+
+    if(i == N_) return;
+
+    //EA has A(i) inserted, EB has B(i) inserted;
+    //both are extended through sites i+1...j-1
+    Tensor EA, EB;
+    if(!A.at(i).isNull())
+        {
+        EA = L_.at(i-1);
+        applyOp(EA,i,(F == 0 ? A.at(i) : multSiteOps(A.at(i),F->at(i))));
+        }
+    if(!B.at(i).isNull())
+        {
+        EB = L_.at(i-1);
+        applyOp(EB,i,(F == 0 ? B.at(i) : multSiteOps(B.at(i),F->at(i))));
+        }
+
+    //Fermionic operators on different sites anticommute
+    const Real sign = (F == 0 ? 1 : -1);
+
+    for(int j = i+1; j <= N_; ++j)
+        {
+        if(EA.isNull() && EB.isNull()) break;
+
+        if(!EA.isNull() && !B.at(j).isNull())
+            {
+            Tensor E = EA;
+            applyOp(E,j,B.at(j));
+            close(E,j,re,im);
+            Cre(i,j) = re;
+            Cim(i,j) = im;
+            }
+        if(!EB.isNull() && !A.at(j).isNull())
+            {
+            Tensor E = EB;
+            applyOp(E,j,A.at(j));
+            close(E,j,re,im);
+            Cre(j,i) = sign*re;
+            Cim(j,i) = sign*im;
+            }
+
+        if(j == N_) break;
+        if(F == 0)
+            {
+            if(!EA.isNull()) applySite(EA,j);
+            if(!EB.isNull()) applySite(EB,j);
+            }
+        else
+            {
+            if(!EA.isNull()) applyOp(EA,j,F->at(j));
+            if(!EB.isNull()) applyOp(EB,j,F->at(j));
+            }
+        }
+    }
+
+template <class Tensor>
+void inline MPSOverlap<Tensor>::
+correlations(const std::vector<Tensor>& A,
+             const std::vector<Tensor>& B,
+             const std::vector<Tensor>& F,
+             Matrix& Cre, Matrix& Cim)
+    {
+    checkNoMPO();
+    if(int(A.size()) <= N_ || int(B.size()) <= N_)
+        Error("MPSOverlap::correlations: operator vectors must have size N+1");
+    if(!F.empty() && int(F.size()) <= N_)
+        Error("MPSOverlap::correlations: string operator vector must have size N+1");
+
+    Cre.ReDimension(N_,N_);
+    Cim.ReDimension(N_,N_);
+    Cre = 0;
+    Cim = 0;
+
+    //Compute all environments up front so the rows
+    //only read shared data and can be done in parallel
+    L(N_-1);
+    R(2);
+
+    const std::vector<Tensor>* pF = (F.empty() ? 0 : &F);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for(int i = 1; i <= N_; ++i)
+        {
+        correlationRow(i,A,B,pF,Cre,Cim);
+        }
+    }
+
+template <class Tensor>
+void inline MPSOverlap<Tensor>::
+correlations(const std::vector<Tensor>& A,
+             const std::vector<Tensor>& B,
+             Matrix& Cre, Matrix& Cim)
+    {
+    correlations(A,B,std::vector<Tensor>(),Cre,Cim);
+    }
+
+template <class Tensor>
+void inline MPSOverlap<Tensor>::
+correlations(const std::vector<Tensor>& A,
+             const std::vector<Tensor>& B,
+             Matrix& C)
+    {
+    Matrix Cim;
+    correlations(A,B,C,Cim);
+    }
+
+#endif
@@ -0,0 +1,338 @@
+//
+// Distributed under the ITensor Library License, Version 1.0.
+//    (See accompanying LICENSE file.)
+//
+#include "opsum.h"
+#include "hambuilder.h"
+#include <algorithm>
+
+using namespace std;
+using boost::format;
+
+//
+// Helper struct for sorting the operators
+// of a term by site (stable, so operators on
+// the same site keep their order)
+//
+struct SiteOrder
+    {
+    bool
+    operator()(const pair<int,SiteOpMethod>& a,
+               const pair<int,SiteOpMethod>& b) const
+        { return a.first < b.first; }
+    };
+
+//
+// A single entry of an MPO tensor W_n:
+// the operator opcode connecting
+// state row on bond n-1 to state col on bond n
+//
+struct OpSumTrans
+    {
+    int row, col, op;
+
+    OpSumTrans(int row_, int col_, int op_)
+        : row(row_), col(col_), op(op_) { }
+
+    bool
+    operator<(const OpSumTrans& o) const
+        {
+        if(row != o.row) return row < o.row;
+        if(col != o.col) return col < o.col;
+        return op < o.op;
+        }
+    };
+
+//Special opcodes (factors are numbered 1,2,...)
+static const int IdOp = 0,
+                 FermiOp = -1;
+
+//States common to every bond of the state machine
+static const int StartState = 1,
+                 DoneState = 2;
+
+OpSum::
+OpSum(const Model& model)
+    :
+    model_(&model)
+    { }
+
+void OpSum::
+addTerm(Real coef, const vector<pair<int,SiteOpMethod> >& ops)
+    {
+    vector<pair<int,SiteOpMethod> > sops(ops);
+    stable_sort(sops.begin(),sops.end(),SiteOrder());
+
+    Term t;
+    t.coef = coef;
+    for(size_t k = 0; k < sops.size(); ++k)
+        {
+        const int j = sops[k].first;
+        if(j < 1 || j > N())
+            {
+            Print(j);
+            Error("OpSum: site out of range");
+            }
+        if(t.factors.empty() || t.factors.back().j != j)
+            {
+            t.factors.push_back(Factor(j));
+            t.string.push_back(false);
+            }
+        t.factors.back().ops.push_back(sops[k].second);
+        }
+    terms_.push_back(t);
+    }
+
+OpSum& OpSum::
+add(Real coef, SiteOpMethod op1, int j1)
+    {
+    vector<pair<int,SiteOpMethod> > ops;
+    ops.push_back(make_pair(j1,op1));
+    addTerm(coef,ops);
+    return *this;
+    }
+
+OpSum& OpSum::
+add(Real coef, SiteOpMethod op1, int j1,
+               SiteOpMethod op2, int j2)
+    {
+    vector<pair<int,SiteOpMethod> > ops;
+    ops.push_back(make_pair(j1,op1));
+    ops.push_back(make_pair(j2,op2));
+    addTerm(coef,ops);
+    return *this;
+    }
+
+OpSum& OpSum::
+add(Real coef, SiteOpMethod op1, int j1,
+               SiteOpMethod op2, int j2,
+               SiteOpMethod op3, int j3)
+    {
+    vector<pair<int,SiteOpMethod> > ops;
+    ops.push_back(make_pair(j1,op1));
+    ops.push_back(make_pair(j2,op2));
+    ops.push_back(make_pair(j3,op3));
+    addTerm(coef,ops);
+    return *this;
+    }
+
+OpSum& OpSum::
+add(Real coef, SiteOpMethod op1, int j1,
+               SiteOpMethod op2, int j2,
+               SiteOpMethod op3, int j3,
+               SiteOpMethod op4, int j4)
+    {
+    vector<pair<int,SiteOpMethod> > ops;
+    ops.push_back(make_pair(j1,op1));
+    ops.push_back(make_pair(j2,op2));
+    ops.push_back(make_pair(j3,op3));
+    ops.push_back(make_pair(j4,op4));
+    addTerm(coef,ops);
+    return *this;
+    }
+
+OpSum& OpSum::
+addFermionic(Real coef, SiteOpMethod op1, int j1,
+                        SiteOpMethod op2, int j2)
+    {
+    if(j1 == j2)
+        {
+        return add(coef,op1,j1,op2,j2);
+        }
+
+    //Anticommute the operators if needed so
+    //that the first one is on the leftmost site
+    if(j1 > j2)
+        {
+        swap(op1,op2);
+        swap(j1,j2);
+        coef *= -1;
+        }
+
+    add(coef,op1,j1,op2,j2);
+
+    //Op1 is followed by the Jordan-Wigner string
+    Term& t = terms_.back();
+    t.factors.front().fermi = true;
+    t.string.front() = true;
+
+    return *this;
+    }
+
+void OpSum::
+toMPO(IQMPO& res, const OptSet& opts) const
+    {
+    const int N = this->N();
+    const Model& model = *model_;
+
+    //
+    // Collect the distinct factors on each site
+    // and label the factors of each term
+    //
+    vector<vector<Factor> > sfac(N+1);
+    vector<vector<int> > tfid(terms_.size());
+    for(size_t t = 0; t < terms_.size(); ++t)
+    Foreach(const Factor& f, terms_[t].factors)
+        {
+        vector<Factor>& sf = sfac.at(f.j);
+        size_t n = 0;
+        while(n < sf.size() && !(sf[n] == f)) ++n;
+        if(n == sf.size()) sf.push_back(f);
+        tfid[t].push_back(n+1);
+        }
+
+    vector<vector<IQTensor> > fop(N+1);
+    vector<vector<QN> > fdiv(N+1);
+    for(int j = 1; j <= N; ++j)
+        {
+        fop[j].resize(sfac[j].size()+1);
+        fdiv[j].resize(sfac[j].size()+1);
+        for(size_t n = 0; n < sfac[j].size(); ++n)
+            {
+            const Factor& f = sfac[j][n];
+            IQTensor op = (model.*f.ops.front())(j);
+            for(size_t k = 1; k < f.ops.size(); ++k)
+                op = multSiteOps(op,(model.*f.ops[k])(j));
+            if(f.fermi) op = multSiteOps(op,model.fermiPhase(j));
+            fop[j][n+1] = op;
+            fdiv[j][n+1] = div(op);
+            }
+        }
+
+    //
+    // Build the state machine: a state on bond n
+    // (between sites n and n+1) is labeled by the
+    // factors of a term applied so far and whether
+    // a fermion string is being applied. States
+    // have the QN -(total div of applied factors),
+    // so that every W_n has zero divergence.
+    //
+    vector<map<vector<int>,int> > states(N+1);
+    vector<vector<QN> > sqn(N+1,vector<QN>(DoneState+1));
+    vector<map<OpSumTrans,Real> > trans(N+1);
+
+    for(size_t t = 0; t < terms_.size(); ++t)
+        {
+        const Term& term = terms_[t];
+        const int nf = term.factors.size();
+        if(nf == 0) continue;
+
+        int row = StartState;
+        QN q;
+        vector<int> key;
+        int m = 0;
+        for(int n = term.factors.front().j; n <= N; ++n)
+            {
+            int op = IdOp;
+            if(n == term.factors.at(m).j)
+                {
+                op = tfid[t].at(m);
+                q -= fdiv[n].at(op);
+                key.push_back(n);
+                key.push_back(op);
+                ++m;
+                if(m == nf)
+                    {
+                    if(q != QN())
+                        {
+                        Print(q);
+                        Error("OpSum: term does not conserve quantum numbers");
+                        }
+                    trans[n][OpSumTrans(row,DoneState,op)] += term.coef;
+                    break;
+                    }
+                }
+            else
+                {
+                op = (term.string.at(m-1) ? FermiOp : IdOp);
+                }
+
+            vector<int> skey(key);
+            skey.push_back(term.string.at(m-1) ? 1 : 0);
+            int& col = states[n][skey];
+            if(col == 0)
+                {
+                col = sqn[n].size();
+                sqn[n].push_back(q);
+                }
+            trans[n][OpSumTrans(row,col,op)] = 1;
+            row = col;
+            }
+        }
+
+    //
+    // Make the link IQIndices, grouping the
+    // states on each bond into QN sectors
+    //
+    vector<IQIndex> links(N+1);
+    vector<vector<int> > pos(N+1);
+    for(int n = 1; n < N; ++n)
+        {
+        map<QN,vector<int> > qstates;
+        for(size_t s = 1; s < sqn[n].size(); ++s)
+            qstates[sqn[n][s]].push_back(s);
+
+        pos[n].resize(sqn[n].size());
+        vector<IndexQN> iq;
+        int p = 0;
+        for(map<QN,vector<int> >::const_iterator it = qstates.begin();
+            it != qstates.end(); ++it)
+            {
+            const vector<int>& st = it->second;
+            for(size_t k = 0; k < st.size(); ++k)
+                pos[n][st[k]] = ++p;
+            iq.push_back(IndexQN(Index(nameint("ol",n),st.size()),it->first));
+            }
+        links[n] = IQIndex(nameint("OL",n),iq);
+        }
+
+    //
+    // Fill in the MPO tensors
+    //
+    res = IQMPO(model);
+    for(int n = 1; n <= N; ++n)
+        {
+        map<OpSumTrans,Real>& tn = trans[n];
+        if(n < N) tn[OpSumTrans(StartState,StartState,IdOp)] = 1;
+        if(n > 1) tn[OpSumTrans(DoneState,DoneState,IdOp)] = 1;
+
+        IQIndex row = (n > 1 ? conj(links[n-1]) : IQIndex::Null()),
+                col = (n < N ? links[n] : IQIndex::Null());
+
+        MPOTensorBuilder<IQTensor> B(row,col);
+        for(map<OpSumTrans,Real>::const_iterator it = tn.begin();
+            it != tn.end(); ++it)
+            {
+            const OpSumTrans& tr = it->first;
+            const IQTensor& op = (tr.op == IdOp   ? model.id(n) :
+                                 (tr.op == FermiOp ? model.fermiPhase(n) :
+                                                     fop[n].at(tr.op)));
+            B.add((n > 1 ? pos[n-1].at(tr.row) : 1),
+                  (n < N ? pos[n].at(tr.col) : 1),
+                  op,it->second);
+            }
+        if(B.numEntries() == 0)
+            {
+            Print(n);
+            Error("OpSum: MPO tensor has no entries");
+            }
+        B.build(res.Anc(n));
+        }
+
+    //
+    // Optionally compress by an SVD sweep
+    //
+    if(opts.getBool("Compress",false))
+        {
+        res.cutoff(opts.getReal("Cutoff",1E-13));
+        res.orthogonalize();
+        }
+    }
+
+void OpSum::
+toMPO(MPO& res, const OptSet& opts) const
+    {
+    IQMPO iqres;
+    toMPO(iqres,opts);
+    res = iqres.toMPO();
+    }
@@ -0,0 +1,162 @@
+//
+// Distributed under the ITensor Library License, Version 1.0.
+//    (See accompanying LICENSE file.)
+//
+#ifndef __ITENSOR_OPSUM_H
+#define __ITENSOR_OPSUM_H
+#include "mpo.h"
+
+//
+// OpSum
+//
+// Holds a sum of weighted products of Model site
+// operators, such as
+//
+//     OpSum H(model);
+//     for(int j = 1; j < N; ++j)
+//         {
+//         H.add(J,  &Model::sz,j,&Model::sz,j+1);
+//         H.add(J/2,&Model::sp,j,&Model::sm,j+1);
+//         H.add(J/2,&Model::sm,j,&Model::sp,j+1);
+//         }
+//     IQMPO W;
+//     H.toMPO(W);
+//
+// and compiles it into an MPO (or IQMPO).
+//
+// The MPO is constructed as a finite state machine
+// whose states on each bond are the distinct partially
+// applied terms ("prefixes"), so that terms sharing
+// their leftmost operators share MPO states. Each
+// state carries a definite quantum number, so the
+// IQMPO has the same QN block structure as a hand-coded
+// one and can be used directly for IQ-DMRG.
+//
+// The state machine can then be compressed by
+// an SVD sweep (see toMPO options below).
+//
+
+class OpSum
+    {
+    public:
+
+    OpSum(const Model& model);
+
+    const Model&
+    model() const { return *model_; }
+
+    int
+    N() const { return model_->N(); }
+
+    int
+    nterms() const { return terms_.size(); }
+
+    //
+    // Add the term coef * Op1(j1) Op2(j2) ...
+    //
+    // Operators on the same site are multiplied
+    // in the order given (rightmost acting first).
+    // All operators are treated as bosonic, i.e.
+    // commuting on different sites.
+    //
+
+    OpSum&
+    add(Real coef, SiteOpMethod op1, int j1);
+
+    OpSum&
+    add(Real coef, SiteOpMethod op1, int j1,
+                   SiteOpMethod op2, int j2);
+
+    OpSum&
+    add(Real coef, SiteOpMethod op1, int j1,
+                   SiteOpMethod op2, int j2,
+                   SiteOpMethod op3, int j3);
+
+    OpSum&
+    add(Real coef, SiteOpMethod op1, int j1,
+                   SiteOpMethod op2, int j2,
+                   SiteOpMethod op3, int j3,
+                   SiteOpMethod op4, int j4);
+
+    //
+    // Add the term coef * Op1(j1) Op2(j2) where Op1 and
+    // Op2 are fermionic operators such as &Model::Cdag
+    // and &Model::C. The Jordan-Wigner string made of
+    // the Model's fermiPhase operators is included.
+    //
+
+    OpSum&
+    addFermionic(Real coef, SiteOpMethod op1, int j1,
+                            SiteOpMethod op2, int j2);
+
+    //
+    // Construct the MPO
+    //
+    // Options recognized:
+    //     Compress - if true, compress the MPO by an
+    //                SVD sweep (default false, so that
+    //                no terms are lost)
+    //     Cutoff - truncation cutoff used for the
+    //              compression (default 1E-13); since
+    //              it is relative to the norm of the MPO,
+    //              small terms may be dropped
+    //
+
+    void
+    toMPO(IQMPO& res, const OptSet& opts = Global::opts()) const;
+
+    void
+    toMPO(MPO& res, const OptSet& opts = Global::opts()) const;
+
+    //
+    // The operators of a term on a single site:
+    // the product ops[0]*ops[1]*... , times the
+    // fermiPhase operator (acting first) if fermi is true
+    //
+    struct Factor
+        {
+        int j;
+        std::vector<SiteOpMethod> ops;
+        bool fermi;
+
+        Factor(int j_ = 0) : j(j_), fermi(false) { }
+
+        bool
+        operator==(const Factor& other) const
+            { return j == other.j && fermi == other.fermi && ops == other.ops; }
+        };
+
+    //
+    // A term is a product of Factors on increasing
+    // sites. If string[n] is true the fermiPhase
+    // operator is placed on the sites between
+    // factors n and n+1.
+    //
+    struct Term
+        {
+        Real coef;
+        std::vector<Factor> factors;
+        std::vector<bool> string;
+
+        Term() : coef(0) { }
+        };
+
+    private:
+
+    /////////////////
+    //
+    // Data Members
+
+    const Model* model_;
+
+    std::vector<Term> terms_;
+
+    //
+    /////////////////
+
+    void
+    addTerm(Real coef, const std::vector<std::pair<int,SiteOpMethod> >& ops);
+
+    }; //class OpSum
+
+#endif
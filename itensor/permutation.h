@@ -106,6 +106,7 @@ set8(int9 *n, int i1, int i2, int i3, int i4, int i5, int i6, int i7, int i8)
     {
     (*n)[1] = i1; (*n)[2] = i2; (*n)[3] = i3; (*n)[4] = i4;
     (*n)[5] = i5; (*n)[6] = i6; (*n)[7] = i7; (*n)[8] = i8;
+    for(int j = 9; j <= NMAX; ++j) (*n)[j] = j;
     }
 
 inline std::ostream& 
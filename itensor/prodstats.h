@@ -30,6 +30,12 @@
 
 #include <map>
 #define NTIMERS 70
+//
+// Apart from the copy counts (see countCopy), the
+// statistics are not synchronized between threads, 
+// so they are only meaningful for programs making 
+// their products from a single thread.
+//
 class Prodstats
         {
         std::vector<Real> time;
@@ -46,6 +52,10 @@ class Prodstats
         std::vector<int> perms_of_6;
         int total, did_matrix;
         int c1,c2,c3,c4;
+        int combine_reshape, combine_copy;
+        int norm_skip;
+        //Copies of shared data made by solo()
+        int it_copies, iqt_copies;
 
         Prodstats()
             {
@@ -55,6 +65,9 @@ class Prodstats
             total = 0;
             did_matrix = 0;
             c1 = c2 = c3 = c4 = 0;
+            combine_reshape = combine_copy = 0;
+            norm_skip = 0;
+            it_copies = iqt_copies = 0;
             perms_of_3 = std::vector<int>(81,0);
             perms_of_4 = std::vector<int>(256,0);
             perms_of_5 = std::vector<int>(3125,0);
@@ -99,6 +112,12 @@ class Prodstats
             std::cerr << "# Case 3 = " << c3 << std::endl;
             std::cerr << "# Case 4 = " << c4 << std::endl;
 
+            std::cerr << "# Combines by reshape = " << combine_reshape << std::endl;
+            std::cerr << "# Combines by copy = " << combine_copy << std::endl;
+            std::cerr << "# Skipped renormalizations = " << norm_skip << std::endl;
+            std::cerr << "# ITensor data copies = " << it_copies << std::endl;
+            std::cerr << "# IQTensor data copies = " << iqt_copies << std::endl;
+
             std::cerr << "Permutations of 3 Count: " << std::endl;
             for(int j = 0; j < (int) perms_of_3.size(); ++j)
                 {
@@ -190,6 +209,17 @@ class Prodstats
         return stats_;
         }
 
+    //Increments n, which may be shared with other 
+    //threads (solo() is called in parallel regions)
+    static void
+    countCopy(int& n)
+        {
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+        ++n;
+        }
+
     };
 
 #endif //COLLECT_PRODSTATS
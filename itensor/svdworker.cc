@@ -219,6 +219,11 @@ svdRank2(ITensor A, const Index& ui, const Index& vi,
            iUU,iVV;
     Vector& DD = eigsKept_.at(b);
 
+    //Products no longer always normalize their result,
+    //but the cutoff below is applied to the unscaled
+    //singular values
+    A.scaleOutNorm();
+
     if(!cplx)
         {
         Matrix M;
@@ -230,11 +235,9 @@ svdRank2(ITensor A, const Index& ui, const Index& vi,
         {
         ITensor Are = realPart(A),
                 Aim = imagPart(A);
-        Are.scaleTo(A.scale());
-        Aim.scaleTo(A.scale());
         Matrix Mre,Mim;
-        Are.toMatrix11NoScale(ui,vi,Mre);
-        Aim.toMatrix11NoScale(ui,vi,Mim);
+        Are.toMatrix11(ui,vi,Mre,A.scale());
+        Aim.toMatrix11(ui,vi,Mim,A.scale());
 
         SVDComplex(Mre,Mim,UU,iUU,DD,VV,iVV);
         }
@@ -365,15 +368,15 @@ svdRank2(IQTensor A, const IQIndex& uI, const IQIndex& vI,
     if(doRelCutoff_)
         {
         Real maxLogNum = -200;
-        A.scaleOutNorm();
         Foreach(const ITensor& t, A.blocks())
             {
-            maxLogNum = max(maxLogNum,t.scale().logNum());
+            maxLogNum = max(maxLogNum,t.normLogNum().logNum());
             }
         refNorm_ = LogNumber(maxLogNum,1);
         }
 
-    A.scaleTo(refNorm_);
+    //The blocks of A are put in units of refNorm_ 
+    //while converting them to matrices
 
     //1. SVD each ITensor within A.
     //   Store results in mmatrix and mvector.
@@ -408,7 +411,7 @@ svdRank2(IQTensor A, const IQIndex& uI, const IQIndex& vI,
         if(!cplx)
             {
             Matrix M(ui->m(),vi->m());
-            t.toMatrix11NoScale(*ui,*vi,M);
+            t.toMatrix11(*ui,*vi,M,refNorm_);
 
             SVD(M,UU,d,VV);
             }
@@ -416,12 +419,10 @@ svdRank2(IQTensor A, const IQIndex& uI, const IQIndex& vI,
             {
             ITensor ret = realPart(t),
                     imt = imagPart(t);
-            ret.scaleTo(refNorm_);
-            imt.scaleTo(refNorm_);
             Matrix Mre(ui->m(),vi->m()),
                    Mim(ui->m(),vi->m());
-            ret.toMatrix11NoScale(*ui,*vi,Mre);
-            imt.toMatrix11NoScale(*ui,*vi,Mim);
+            ret.toMatrix11(*ui,*vi,Mre,refNorm_);
+            imt.toMatrix11(*ui,*vi,Mim,refNorm_);
 
             SVDComplex(Mre,Mim,
                        UU,iUmatrix.at(itenind),
@@ -623,8 +624,8 @@ svdRank2(IQTensor A, const IQIndex& uI, const IQIndex& vI,
         V = V*IQComplex_1() + iV*IQComplex_i();
         }
 
-    //Originally eigs were found by calling
-    //toMatrix11NoScale, so put the scale back in
+    //Singular values were found in units
+    //of refNorm_, so put the scale back in
     D *= refNorm_;
 
     //Update truncerr_ and eigsKept_
@@ -686,7 +687,13 @@ diag_hermitian(ITensor rho, ITensor& U, ITSparse& D, int b,
         Error("Tensor must have one unprimed index");
         }
 
-    if(!doRelCutoff_) rho.scaleTo(refNorm_);
+    //Products no longer always normalize their result,
+    //so put the data of rho in units of its norm
+    //(the cutoff below is applied to the scaled eigenvalues)
+    if(doRelCutoff_) rho.scaleOutNorm();
+
+    //Units for the elements of rho
+    const LogNumber rscale = (doRelCutoff_ ? rho.scale() : refNorm_);
 
     //Do the diagonalization
     Vector& DD = eigsKept_.at(b);
@@ -694,7 +701,7 @@ diag_hermitian(ITensor rho, ITensor& U, ITSparse& D, int b,
     if(!cplx)
         {
         Matrix R;
-        rho.toMatrix11NoScale(active,primed(active),R);
+        rho.toMatrix11(active,primed(active),R,rscale);
         R *= -1.0; 
         EigenValues(R,DD,UU); 
         DD *= -1.0;
@@ -704,10 +711,8 @@ diag_hermitian(ITensor rho, ITensor& U, ITSparse& D, int b,
         Matrix Mr,Mi;
         ITensor rrho = realPart(rho),
                 irho = imagPart(rho);
-        rrho.scaleTo(rho.scale());
-        irho.scaleTo(rho.scale());
-        rrho.toMatrix11NoScale(primed(active),active,Mr);
-        irho.toMatrix11NoScale(primed(active),active,Mi);
+        rrho.toMatrix11(primed(active),active,Mr,rscale);
+        irho.toMatrix11(primed(active),active,Mi,rscale);
         Mr *= -1.0; 
         Mi *= -1.0; 
         HermitianEigenvalues(Mr,Mi,DD,UU,iUU); 
@@ -773,7 +778,7 @@ diag_hermitian(ITensor rho, ITensor& U, ITSparse& D, int b,
     Index newmid(active.rawname(),m,active.type());
     U = ITensor(active,newmid,UU.Columns(1,m));
     D = ITSparse(primed(newmid),newmid,DD);
-    D *= rho.scale();
+    D *= rscale;
 
     if(cplx)
         {
@@ -830,10 +835,9 @@ diag_hermitian(IQTensor rho, IQTensor& U, IQTSparse& D, int b,
         {
         //DO_IF_DEBUG(cout << "Doing relative cutoff\n";)
         Real maxLogNum = -200;
-        rho.scaleOutNorm();
         Foreach(const ITensor& t, rho.blocks())
             {
-            maxLogNum = max(maxLogNum,t.scale().logNum());
+            maxLogNum = max(maxLogNum,t.normLogNum().logNum());
             }
         refNorm_ = LogNumber(maxLogNum,1);
         }
@@ -845,7 +849,8 @@ diag_hermitian(IQTensor rho, IQTensor& U, IQTSparse& D, int b,
     //cerr << boost::format("refNorm = %.1E (lognum = %f, sign = %d)\n\n")
     //%Real(refNorm)%refNorm.logNum()%refNorm.sign();
 
-    rho.scaleTo(refNorm_);
+    //The blocks of rho are put in units of refNorm_
+    //while converting them to matrices
 
     //1. Diagonalize each ITensor within rho.
     //   Store results in mmatrix and mvector.
@@ -871,7 +876,7 @@ diag_hermitian(IQTensor rho, IQTensor& U, IQTSparse& D, int b,
         if(!cplx)
             {
             Matrix M;
-            t.toMatrix11NoScale(a,primed(a),M);
+            t.toMatrix11(a,primed(a),M,refNorm_);
             M *= -1;
             EigenValues(M,d,UU);
             d *= -1;
@@ -880,12 +885,10 @@ diag_hermitian(IQTensor rho, IQTensor& U, IQTSparse& D, int b,
             {
             ITensor ret = realPart(t),
                     imt = imagPart(t);
-            ret.scaleTo(refNorm_);
-            imt.scaleTo(refNorm_);
             Matrix Mr,Mi;
             Matrix &iUU = imatrix.at(itenind);
-            ret.toMatrix11NoScale(primed(a),a,Mr);
-            imt.toMatrix11NoScale(primed(a),a,Mi);
+            ret.toMatrix11(primed(a),a,Mr,refNorm_);
+            imt.toMatrix11(primed(a),a,Mi,refNorm_);
             Mr *= -1;
             Mi *= -1;
             HermitianEigenvalues(Mr,Mi,d,UU,iUU);
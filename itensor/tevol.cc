@@ -3,6 +3,7 @@
 //    (See accompanying LICENSE file.)
 //
 #include "tevol.h"
+#include <set>
 
 using namespace std;
 using boost::format;
@@ -351,14 +352,13 @@ imagTEvol(const MPOt<Tensor>& H, Real ttotal, Real tstep,
             {
             //Do time evol using MPO w/out projection
             //psi' = psi-t*H*(psi-t/2*H*(psi-t/3*H*(psi-t/4*H*psi)))
+            //Each step is fit variationally at the maxm of psi
             MPST dpsi(psi);
             for(int o = Order; o >= 1; --o)
                 {
-                exactApplyMPO(dpsi,H,dpsi);
-                dpsi *= -estep/(1.*o);
-                dpsi += psi;
+                fitApplyMPO(psi,-estep/(1.*o),dpsi,H,dpsi);
                 }
-            psi = dpsi;
+            psi.swap(dpsi);
 
             tsofar += estep;
             }
@@ -806,6 +806,208 @@ imagTEvol(const MPOt<IQTensor>& H, Real ttotal, Real tstep,
           MPSt<IQTensor>& psi, const OptSet& opts);
 
 
+//
+// Helpers for gateTEvol in Vidal form
+//
+// The MPS is stored as tensors B[j] together with
+// the singular values L[b] on each bond b (between sites b and b+1),
+// so that the wavefunction is B[1]*B[2]*...*B[N] and the Schmidt 
+// decomposition across bond b-1 is given by L[b-1]*B[b]*...*B[N].
+//
+// A gate acting on sites b,b+1 is applied as in Hastings' version of
+// TEBD [J. Math. Phys. 50, 095207 (2009)] which avoids dividing by
+// the singular values:
+//
+//   Phi = gate * B[b] * B[b+1],   theta = L[b-1] * Phi = U*S*V
+//   B[b+1] = V,  L[b] = S,  B[b] = Phi * conj(V)
+//
+// Each gate reads L[b-1] and writes only B[b], B[b+1] and L[b],
+// so gates on disjoint bonds can be applied in any order or
+// at the same time.
+//
+// B[b] = Phi * conj(V) is only right-orthogonal for a unitary
+// gate and no truncation, so fromVidal re-orthogonalizes the MPS.
+//
+
+template <class Tensor>
+struct VidalMPS
+    {
+    typedef typename Tensor::SparseT
+    SparseT;
+
+    std::vector<Tensor> B;
+    std::vector<SparseT> L;
+
+    explicit
+    VidalMPS(int N) : B(N+1), L(N+1) { }
+    };
+
+template <class Tensor>
+void
+toVidal(MPSt<Tensor>& psi, VidalMPS<Tensor>& V)
+    {
+    typedef typename Tensor::IndexT
+    IndexT;
+    typedef typename Tensor::SparseT
+    SparseT;
+
+    const int N = psi.N();
+    const Model& model = psi.model();
+
+    psi.position(N);
+
+    SVDWorker W(psi.svd());
+    Tensor M = psi.A(N);
+    for(int b = N-1; b >= 1; --b)
+        {
+        Tensor AA = psi.A(b) * M;
+
+        Tensor U(IndexT(model.si(b))),
+               Vt;
+        if(b > 1) U = Tensor(psi.LinkInd(b-1),model.si(b));
+        SparseT D;
+        W.svd(b,AA,U,D,Vt);
+        D *= 1./D.norm();
+
+        V.B.at(b+1) = Vt;
+        V.L.at(b) = D;
+        M = U*D;
+        }
+    V.B.at(1) = M;
+    }
+
+template <class Tensor>
+void
+fromVidal(const VidalMPS<Tensor>& V, MPSt<Tensor>& psi)
+    {
+    const int N = psi.N();
+    for(int j = 1; j <= N; ++j)
+        {
+        psi.Anc(j) = V.B.at(j);
+        }
+    //Imaginary time gates and truncation leave
+    //the B's only approximately right-orthogonal
+    psi.leftLim(0);
+    psi.rightLim(N+1);
+    psi.orthogonalize();
+    }
+
+template <class Tensor>
+void
+applyVidalGate(const BondGate<Tensor>& G, const Model& model,
+               const SVDWorker& svd, VidalMPS<Tensor>& V)
+    {
+    typedef typename Tensor::IndexT
+    IndexT;
+    typedef typename Tensor::SparseT
+    SparseT;
+
+    const int b = min(G.i(),G.j());
+
+    Tensor Phi = V.B.at(b) * V.B.at(b+1);
+    Phi *= G.gate();
+    Phi.noprime();
+
+    //theta = L(b-1) B(b) B(b+1) G is the full two-site 
+    //wavefunction; its left link is the one from L(b-1)
+    Tensor theta = (b == 1 ? Phi : V.L.at(b-1) * Phi);
+
+    Tensor U(IndexT(model.si(b))),
+           Vt;
+    if(b > 1) U = Tensor(commonIndex(theta,V.L.at(b-1),Link),model.si(b));
+    SparseT D;
+
+    //Each thread uses its own SVDWorker since
+    //svd records information about the truncation
+    SVDWorker W(svd);
+    W.svd(b,theta,U,D,Vt);
+    D *= 1./D.norm();
+
+    V.B.at(b) = Phi * conj(Vt);
+    V.B.at(b+1) = Vt;
+    V.L.at(b) = D;
+    }
+
+//
+// Splits gatelist into layers of consecutive gates
+// acting on disjoint pairs of neighboring sites
+//
+template <class Tensor>
+void
+commutingLayers(const list<BondGate<Tensor> >& gatelist, 
+                vector<vector<const BondGate<Tensor>*> >& layers)
+    {
+    layers.clear();
+    set<int> used;
+    Foreach(const BondGate<Tensor>& G, gatelist)
+        {
+        if(abs(G.i()-G.j()) != 1)
+            {
+            Print(G.i());
+            Print(G.j());
+            Error("Vidal mode of gateTEvol requires nearest-neighbor gates");
+            }
+        if(layers.empty() || used.count(G.i()) || used.count(G.j()))
+            {
+            layers.push_back(vector<const BondGate<Tensor>*>());
+            used.clear();
+            }
+        layers.back().push_back(&G);
+        used.insert(G.i());
+        used.insert(G.j());
+        }
+    }
+
+template <class Tensor>
+void
+gateTEvolVidal(const list<BondGate<Tensor> >& gatelist, int nt, 
+               MPSt<Tensor>& psi, const OptSet& opts)
+    {
+    bool verbose = opts.getBool("Verbose",false);
+
+    const Model& model = psi.model();
+
+    vector<vector<const BondGate<Tensor>*> > layers;
+    commutingLayers(gatelist,layers);
+
+    if(verbose) 
+        cout << "Gates grouped into " << layers.size() << " layers" << endl;
+
+    VidalMPS<Tensor> V(psi.N());
+    toVidal(psi,V);
+
+    for(int tt = 1; tt <= nt; ++tt)
+        {
+        for(size_t l = 0; l < layers.size(); ++l)
+            {
+            const vector<const BondGate<Tensor>*>& layer = layers[l];
+            const int ng = layer.size();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+            for(int g = 0; g < ng; ++g)
+                {
+                applyVidalGate(*(layer[g]),model,psi.svd(),V);
+                }
+            }
+
+        if(verbose)
+            {
+            Real percentdone = (100.*tt)/nt;
+            if(percentdone < 99.5)
+                {
+                cout << format("\b\b\b%2.f%%") % percentdone;
+                cout.flush();
+                }
+            }
+        }
+
+    fromVidal(V,psi);
+
+    if(opts.getBool("DoNormalize",false))
+        psi.normalize();
+    }
+
 template <class Tensor>
 void
 gateTEvol(const list<BondGate<Tensor> >& gatelist, Real ttotal, Real tstep, 
@@ -820,8 +1022,19 @@ gateTEvol(const list<BondGate<Tensor> >& gatelist, Real ttotal, Real tstep,
         Error("Timestep not commensurate with total time");
         }
 
-    Real tsofar = 0;
     if(verbose) cout << "Doing " << nt << " steps" << endl;
+
+    if(opts.getBool("Vidal",false))
+        {
+        gateTEvolVidal(gatelist,nt,psi,opts);
+        if(verbose) 
+            {
+            cout << format("\nTotal time evolved = %.5f\n") % (nt*tstep) << endl;
+            }
+        return;
+        }
+
+    Real tsofar = 0;
     for(int tt = 1; tt <= nt; ++tt)
         {
         Foreach(const BondGate<Tensor> & G, gatelist)
@@ -36,6 +36,15 @@ derivMPS(const std::vector<Tensor>& psi, const MPOt<Tensor>& H,
 //
 // Options recognized:
 //     Verbose - print useful information to stdout
+//     Vidal - if true, keep psi in Vidal (Gamma-Lambda) form during
+//             the evolution, storing the singular values on each bond.
+//             Consecutive gates acting on disjoint pairs of neighboring
+//             sites (such as the even and odd layers of a Trotter step)
+//             are then applied concurrently, without moving the
+//             orthogonality center. Gates must act on nearest neighbors.
+//             (Concurrency requires compiling with OpenMP enabled.)
+//     DoNormalize - if true, normalize psi at the end of the evolution
+//                   (Vidal mode only)
 //
 template <class Tensor>
 void
@@ -29,6 +29,8 @@ extern "C" void dgemv_(char*,int*,int*,Real*,Real*,int*,Real*,int*,
 				    Real*,Real*,int*);
 extern "C" void dgemm_(char*,char*,int*,int*,int*,Real*,Real*,int*,
 				Real*,int*,Real*,Real*,int*);
+extern "C" void sgemm_(char*,char*,int*,int*,int*,float*,float*,int*,
+				float*,int*,float*,float*,int*);
 #else
 void daxpy(int n, Real alpha, Real* x, int incx, Real* y, int incy);
 
@@ -436,6 +438,15 @@ mult(const MatrixRef & M1, const MatrixRef & M2, MatrixRef & M3, int noclear)
     dgemm_(&transa,&transb,&m,&n,&k,&sca,pa,&lda,pb,&ldb, &beta, pc, &ldc);
     }
 
+void 
+sgemm(char transa, char transb, int m, int n, int k, float alpha,
+      const float* a, int lda, const float* b, int ldb,
+      float beta, float* c, int ldc)
+    {
+    sgemm_(&transa,&transb,&m,&n,&k,&alpha,const_cast<float*>(a),&lda,
+           const_cast<float*>(b),&ldb,&beta,c,&ldc);
+    }
+
 #else
 
 xxxx
@@ -173,6 +173,12 @@ void mult(const MatrixRef &, const MatrixRef &, MatrixRef &,int noclear = 0);
 void mult(const MatrixRef &, const VectorRef &, VectorRef &,int noclear = 0);
 void add(const MatrixRef &, const MatrixRef &, MatrixRef &,int noclear = 0);
 
+// Single precision C = alpha*op(A)*op(B) + beta*C (BLAS sgemm),
+// the arrays being column-major with leading dimensions lda, ldb, ldc
+void sgemm(char transa, char transb, int m, int n, int k, float alpha,
+           const float* a, int lda, const float* b, int ldb,
+           float beta, float* c, int ldc);
+
 class MatrixRef
     {
 public:
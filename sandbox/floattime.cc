@@ -0,0 +1,81 @@
+//
+// Compares LocalMPO in double precision and with
+// the FloatProduct option (single precision edge
+// tensors and products, see localop.h): heap memory
+// held by the edge tensors, time to make them and
+// time per product at the center bond, and the
+// deviation of the float product from the double one.
+//
+// Usage: floattime [maxm] [reps]
+//
+// Heap usage is read with mallinfo2 (glibc).
+//
+#include "core.h"
+#include "cputime.h"
+#include "model/spinhalf.h"
+#include "hams/Heisenberg.h"
+#include <malloc.h>
+using boost::format;
+using namespace std;
+
+static Real
+heapMB() { return mallinfo2().uordblks/(1024.*1024.); }
+
+int
+main(int argc, char* argv[])
+    {
+    const int maxm = (argc > 1 ? atoi(argv[1]) : 200);
+    const int reps = (argc > 2 ? atoi(argv[2]) : 20);
+    const int N = 40;
+    const int b = N/2;
+
+    SpinHalf model(N);
+    IQMPO H = Heisenberg(model);
+
+    InitState initState(model);
+    for(int j = 1; j <= N; ++j)
+        initState.set(j,j%2==1 ? &SpinHalf::Up : &SpinHalf::Dn);
+    IQMPS psi(model,initState);
+
+    Sweeps sweeps(5);
+    sweeps.maxm() = 20,50,100,maxm;
+    sweeps.cutoff() = 0;
+    dmrg(psi,H,sweeps,Opt("Quiet",true));
+
+    psi.position(b);
+    const IQTensor phi = psi.bondTensor(b);
+    cout << format("N = %d, m = %d at bond %d\n") % N % psi.LinkInd(b).m() % b;
+
+    cout << format("%8s %12s %12s %12s %12s\n")
+            % "mode" % "env (MB)" % "envs (s)" % "product (ms)" % "rel. dev.";
+
+    IQTensor Hphi_double;
+    for(int f = 0; f <= 1; ++f)
+        {
+        const Real heap0 = heapMB();
+
+        LocalMPO<IQTensor> PH(H,Opt("FloatProduct",f==1));
+        cpu_time cpu;
+        PH.position(b,psi);
+        const Real tenv = cpu.sincemark().time;
+
+        const Real env = heapMB()-heap0;
+
+        IQTensor Hphi;
+        cpu.mark();
+        for(int n = 1; n <= reps; ++n)
+            {
+            PH.product(phi,Hphi);
+            }
+        const Real tprod = cpu.sincemark().time;
+
+        Real dev = 0;
+        if(f == 0) Hphi_double = Hphi;
+        else       dev = (Hphi-Hphi_double).norm()/Hphi_double.norm();
+
+        cout << format("%8s %12.2f %12.3f %12.2f %12.1E\n")
+                % (f == 1 ? "float" : "double") % env % tenv % (tprod*1E3/reps) % dev;
+        }
+
+    return 0;
+    }
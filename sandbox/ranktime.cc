@@ -0,0 +1,92 @@
+//
+// Times basic operations on ITensors of rank 4 through 8
+// (permutation, contracting product, product with a
+// diagonal ITSparse and trace), for comparing builds
+// or versions of the library.
+//
+// Each tensor has about 2^16 elements.
+//
+#include "core.h"
+#include "cputime.h"
+using boost::format;
+using namespace std;
+
+int
+main(int argc, char* argv[])
+    {
+    const int reps = (argc > 1 ? atoi(argv[1]) : 200);
+
+    cout << format("%4s %4s %12s %12s %12s %12s\n")
+            % "rank" % "dim" % "permute" % "product" % "diag" % "trace";
+    cout << "(microseconds per call)" << endl;
+
+    for(int r = 4; r <= 8; ++r)
+        {
+        const int d = int(pow(65536.,1./r)+0.5);
+
+        vector<Index> ind(r),
+                      rev(r);
+        for(int j = 0; j < r; ++j)
+            {
+            ind[j] = Index(nameint("i",j+1),d);
+            rev[r-1-j] = ind[j];
+            }
+
+        ITensor T(IndexSet<Index>(ind,r,0));
+        T.randomize();
+
+        const IndexSet<Index> revset(rev,r,0);
+
+        //Shares the non-adjacent indices 1 and 3 with T
+        Index x("x",d);
+        ITensor U(ind[0],ind[2],x);
+        U.randomize();
+
+        Vector diag(d);
+        diag.Randomize();
+        ITSparse S(ind[1],primed(ind[1]),diag);
+
+        Real tot = 0;
+
+        cpu_time cpu;
+        for(int n = 1; n <= reps; ++n)
+            {
+            ITensor P(revset,T);
+            tot += P.normNoScale();
+            }
+        const Real tperm = cpu.sincemark().time;
+
+        cpu.mark();
+        for(int n = 1; n <= reps; ++n)
+            {
+            ITensor R = T*U;
+            tot += R.normNoScale();
+            }
+        const Real tprod = cpu.sincemark().time;
+
+        cpu.mark();
+        for(int n = 1; n <= reps; ++n)
+            {
+            ITensor R = S*T;
+            tot += R.normNoScale();
+            }
+        const Real tdiag = cpu.sincemark().time;
+
+        cpu.mark();
+        for(int n = 1; n <= reps; ++n)
+            {
+            ITensor R(T);
+            R.trace(ind[0],ind[r-1]);
+            tot += R.normNoScale();
+            }
+        const Real ttrace = cpu.sincemark().time;
+
+        const Real us = 1E6/reps;
+        cout << format("%4d %4d %12.1f %12.1f %12.1f %12.1f\n")
+                % r % d % (tperm*us) % (tprod*us) % (tdiag*us) % (ttrace*us);
+
+        if(tot == 0) cout << "(zero result)" << endl;
+        }
+
+    return 0;
+    }
@@ -0,0 +1,216 @@
+#include "test.h"
+#include "tevol.h"
+#include "model/spinhalf.h"
+#include "model/hubbard.h"
+#include <boost/test/unit_test.hpp>
+
+struct BondGateDefaults
+    {
+    static const int N = 4;
+    SpinHalf shmodel;
+    Hubbard hubmodel;
+
+    BondGateDefaults() :
+    shmodel(N),
+    hubmodel(N)
+        { }
+
+    ~BondGateDefaults() { }
+
+    };
+
+//
+// Reference exp(-tau*H) computed by summing
+// the Taylor series to high order
+//
+template <class Tensor>
+Tensor
+taylorExp(const Model& model, int i, int j, Tensor H, Real tau, bool real_time)
+    {
+    H *= -tau;
+    Tensor unit = model.id(i)*model.id(j);
+    if(real_time || isComplex(H))
+        {
+        unit *= Tensor::Complex_1();
+        }
+    if(real_time)
+        {
+        H *= Tensor::Complex_i();
+        }
+    Tensor term = H, res;
+    H.mapprime(1,2);
+    H.mapprime(0,1);
+    for(int ord = 100; ord >= 1; --ord)
+        {
+        term /= ord;
+        res = unit + term;
+        term = res * H;
+        term.mapprime(2,1);
+        }
+    return res;
+    }
+
+BOOST_FIXTURE_TEST_SUITE(BondGateTest,BondGateDefaults)
+
+TEST(HeisenbergImagTime)
+    {
+    const Real tau = 0.1;
+    IQTensor H = shmodel.sz(1)*shmodel.sz(2)
+               + 0.5*shmodel.sp(1)*shmodel.sm(2)
+               + 0.5*shmodel.sm(1)*shmodel.sp(2);
+
+    BondGate<IQTensor> G(shmodel,1,2,BondGate<IQTensor>::tImag,tau,H);
+    IQTensor diff = G.gate() - taylorExp(shmodel,1,2,H,tau,false);
+    CHECK(diff.norm() < 1E-10);
+
+    ITensor Hi = H.toITensor();
+    BondGate<ITensor> Gi(shmodel,1,2,BondGate<ITensor>::tImag,tau,Hi);
+    ITensor diffi = Gi.gate() - taylorExp<ITensor>(shmodel,1,2,Hi,tau,false);
+    CHECK(diffi.norm() < 1E-10);
+    }
+
+TEST(HeisenbergRealTime)
+    {
+    const Real tau = 0.05;
+    IQTensor H = shmodel.sz(2)*shmodel.sz(3)
+               + 0.5*shmodel.sp(2)*shmodel.sm(3)
+               + 0.5*shmodel.sm(2)*shmodel.sp(3);
+
+    BondGate<IQTensor> G(shmodel,2,3,BondGate<IQTensor>::tReal,tau,H);
+    IQTensor diff = G.gate() - taylorExp(shmodel,2,3,H,tau,true);
+    CHECK(diff.norm() < 1E-10);
+    }
+
+TEST(ComplexBondH)
+    {
+    //i*(S+S- - S-S+) is Hermitian
+    const Real tau = 0.1;
+    IQTensor H = (shmodel.sz(1)*shmodel.sz(2))*IQComplex_1()
+               + (0.5*shmodel.sp(1)*shmodel.sm(2)
+                - 0.5*shmodel.sm(1)*shmodel.sp(2))*IQComplex_i();
+
+    BondGate<IQTensor> G(shmodel,1,2,BondGate<IQTensor>::tImag,tau,H);
+    IQTensor diff = G.gate() - taylorExp(shmodel,1,2,H,tau,false);
+    CHECK(diff.norm() < 1E-10);
+
+    BondGate<IQTensor> Gr(shmodel,1,2,BondGate<IQTensor>::tReal,tau,H);
+    IQTensor diffr = Gr.gate() - taylorExp(shmodel,1,2,H,tau,true);
+    CHECK(diffr.norm() < 1E-10);
+
+    ITensor Hi = H.toITensor();
+    BondGate<ITensor> Gi(shmodel,1,2,BondGate<ITensor>::tReal,tau,Hi);
+    ITensor diffi = Gi.gate() - taylorExp<ITensor>(shmodel,1,2,Hi,tau,true);
+    CHECK(diffi.norm() < 1E-10);
+    }
+
+TEST(HubbardImagTime)
+    {
+    const Real tau = 0.2, U = 4;
+    IQTensor H = U*hubmodel.Nupdn(1)*hubmodel.id(2)
+               + hubmodel.Cdagup(1)*hubmodel.Cup(2)
+               + hubmodel.Cdagup(2)*hubmodel.Cup(1);
+
+    BondGate<IQTensor> G(hubmodel,1,2,BondGate<IQTensor>::tImag,tau,H);
+    IQTensor diff = G.gate() - taylorExp(hubmodel,1,2,H,tau,false);
+    CHECK(diff.norm() < 1E-10);
+
+    //Second gate with the same bondH and tau
+    //should match (and come from the cache)
+    BondGate<IQTensor> G2(hubmodel,1,2,BondGate<IQTensor>::tImag,tau,H);
+    CHECK((G2.gate()-G.gate()).norm() < 1E-14);
+    }
+
+TEST(VidalTEvol)
+    {
+    const int N = 10;
+    SpinHalf model(N);
+    const Real tstep = 0.05,
+               ttotal = 0.5;
+
+    //Second order Trotter sequence: odd, even, odd bonds
+    std::list<BondGate<IQTensor> > gates;
+    for(int pass = 1; pass <= 3; ++pass)
+        {
+        const Real tau = (pass == 2 ? tstep : tstep/2);
+        for(int b = (pass == 2 ? 2 : 1); b < N; b += 2)
+            {
+            IQTensor H = model.sz(b)*model.sz(b+1)
+                       + 0.5*model.sp(b)*model.sm(b+1)
+                       + 0.5*model.sm(b)*model.sp(b+1);
+            gates.push_back(BondGate<IQTensor>(model,b,b+1,BondGate<IQTensor>::tImag,tau,H));
+            }
+        }
+
+    InitState init(model);
+    for(int j = 1; j <= N; ++j)
+        init.set(j,j%2==1 ? &SpinHalf::Up : &SpinHalf::Dn);
+
+    IQMPS psi1(model,init),
+          psi2(model,init);
+    psi1.cutoff(1E-12);
+    psi2.cutoff(1E-12);
+
+    gateTEvol(gates,ttotal,tstep,psi1);
+    gateTEvol(gates,ttotal,tstep,psi2,Opt("Vidal",true));
+
+    CHECK(checkQNs(psi2));
+
+    Real n1 = psiphi(psi1,psi1),
+         n2 = psiphi(psi2,psi2),
+         o12 = psiphi(psi1,psi2);
+    CHECK_CLOSE(o12/sqrt(n1*n2),1,1E-6);
+    //Differences due to truncation
+    CHECK_CLOSE(n2/n1,1,1E-4);
+
+    //Imaginary time gates are not unitary, so psi2 
+    //must have been re-orthogonalized for its norm
+    //(computed from the orthogonality center) to be exact
+    CHECK(psi2.isOrtho());
+    CHECK_CLOSE(sqr(psi2.norm())/n2,1,1E-10);
+    }
+
+TEST(VidalRealTime)
+    {
+    const int N = 10;
+    SpinHalf model(N);
+    const Real tstep = 0.05,
+               ttotal = 0.5;
+
+    std::list<BondGate<IQTensor> > gates;
+    for(int pass = 1; pass <= 3; ++pass)
+        {
+        const Real tau = (pass == 2 ? tstep : tstep/2);
+        for(int b = (pass == 2 ? 2 : 1); b < N; b += 2)
+            {
+            IQTensor H = model.sz(b)*model.sz(b+1)
+                       + 0.5*model.sp(b)*model.sm(b+1)
+                       + 0.5*model.sm(b)*model.sp(b+1);
+            gates.push_back(BondGate<IQTensor>(model,b,b+1,BondGate<IQTensor>::tReal,tau,H));
+            }
+        }
+
+    InitState init(model);
+    for(int j = 1; j <= N; ++j)
+        init.set(j,j%2==1 ? &SpinHalf::Up : &SpinHalf::Dn);
+
+    IQMPS psi1(model,init),
+          psi2(model,init);
+    psi1.cutoff(1E-12);
+    psi2.cutoff(1E-12);
+
+    gateTEvol(gates,ttotal,tstep,psi1);
+    gateTEvol(gates,ttotal,tstep,psi2,Opt("Vidal",true));
+
+    CHECK(checkQNs(psi2));
+    CHECK(psi2.isOrtho());
+
+    Real n1 = psiphi(psi1,psi1),
+         n2 = psiphi(psi2,psi2);
+    Real ore = 0, oim = 0;
+    psiphi(psi1,psi2,ore,oim);
+    //Real time evolution is unitary
+    CHECK_CLOSE(n2,1,1E-6);
+    CHECK_CLOSE(sqrt(ore*ore+oim*oim)/sqrt(n1*n2),1,1E-6);
+    }
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -156,4 +156,47 @@ TEST(Product)
 
 }
 
+
+TEST(AdjacentIndices)
+{
+    //b3 and b4 are adjacent in storage, so combining
+    //them only relabels the indices of A
+    ITensor A(b2,b3,b4,b5);
+    A.randomize();
+
+    Combiner c(b3,b4);
+    c.init();
+    Index r = c.right();
+
+    ITensor cA = c * A;
+    CHECK_EQUAL(cA.r(),3);
+    CHECK(hasindex(cA,r));
+
+    //Same indices in the opposite order,
+    //which requires a permutation
+    Combiner cp(b4,b3);
+    cp.init();
+    Index rp = cp.right();
+
+    ITensor cpA = cp * A;
+
+    for(int i2 = 1; i2 <= b2.m(); ++i2)
+    for(int i3 = 1; i3 <= b3.m(); ++i3)
+    for(int i4 = 1; i4 <= b4.m(); ++i4)
+    for(int i5 = 1; i5 <= b5.m(); ++i5)
+    {
+        const Real val = A(b2(i2),b3(i3),b4(i4),b5(i5));
+        CHECK_CLOSE(cA(b2(i2),r(i3+b3.m()*(i4-1)),b5(i5)),val,1E-10);
+        CHECK_CLOSE(cpA(b2(i2),rp(i4+b4.m()*(i3-1)),b5(i5)),val,1E-10);
+    }
+
+    //Modifying the combined tensor must not modify A
+    ITensor Acopy(A);
+    cA *= 2;
+    CHECK((A-Acopy).norm() < 1E-12);
+
+    ITensor ucA = c * cA;
+    CHECK(((ucA-2*A).norm()) < 1E-10);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
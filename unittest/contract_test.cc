@@ -0,0 +1,112 @@
+#include "test.h"
+#include "contract.h"
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+struct ContractDefaults
+    {
+    const Index a,b,c,d;
+
+    ContractDefaults() :
+    a(Index("a",10)),
+    b(Index("b",10)),
+    c(Index("c",10)),
+    d(Index("d",3))
+        { }
+
+    ~ContractDefaults() { }
+
+    };
+
+BOOST_FIXTURE_TEST_SUITE(ContractTest,ContractDefaults)
+
+TEST(MatrixVector)
+    {
+    //A(a,b) B(b,c) v(c): contracting B with v
+    //first avoids the a*b*c matrix product
+    vector<vector<int> > labels(3);
+    labels[0].push_back(0); labels[0].push_back(1);
+    labels[1].push_back(1); labels[1].push_back(2);
+    labels[2].push_back(2);
+    vector<Real> sizes(3,10);
+
+    ContractOrder co(labels,sizes);
+    CHECK_CLOSE(co.cost(),200,1E-10);
+    CHECK_CLOSE(ContractOrder::leftToRightCost(labels,sizes),1100,1E-10);
+    CHECK_EQUAL(co.sequence().size(),2);
+    CHECK(co.sequence().front() == make_pair(1,2));
+
+    //The greedy search finds the same order here
+    ContractOrder cg(labels,sizes,Opt("ExhaustiveMax",1));
+    CHECK_CLOSE(cg.cost(),200,1E-10);
+
+    ITensor A(a,b), B(b,c), v(c);
+    A.randomize();
+    B.randomize();
+    v.randomize();
+
+    ITensor ref = A * B * v;
+    CHECK((contract(A,B,v)-ref).norm() < 1E-10);
+    }
+
+TEST(Network)
+    {
+    //A ring of four tensors with dangling indices
+    ITensor A(a,b,d), B(b,c), C(c,primed(a)), D(primed(a),a,primed(d));
+    A.randomize();
+    B.randomize();
+    C.randomize();
+    D.randomize();
+
+    ITensor ref = A * B * C * D;
+
+    Contractor<ITensor> Ctr;
+    ITensor res = Ctr(A,B,C,D);
+    CHECK((res-ref).norm() < 1E-10*ref.norm());
+    CHECK_EQUAL(Ctr.numCached(),1);
+
+    //Same structure: order comes from the cache
+    B.randomize();
+    ref = A * B * C * D;
+    res = Ctr(A,B,C,D);
+    CHECK((res-ref).norm() < 1E-10*ref.norm());
+    CHECK_EQUAL(Ctr.numCached(),1);
+
+    //The inputs are not modified
+    CHECK_EQUAL(A.r(),3);
+    CHECK(hasindex(A,d));
+
+    Contractor<ITensor> greedy(Opt("ExhaustiveMax",2));
+    res = greedy(A,B,C,D);
+    CHECK((res-ref).norm() < 1E-10*ref.norm());
+    }
+
+TEST(IQNetwork)
+    {
+    const Index su("su",1,Site), sd("sd",1,Site),
+                lu("lu",2), ld("ld",2),
+                ru("ru",3), rd("rd",3);
+    IQIndex S("S",su,QN(+1),sd,QN(-1),Out),
+            L("L",lu,QN(+1),ld,QN(-1),Out),
+            R("R",ru,QN(+2),rd,QN(0),Out);
+
+    //L(in) x S(in) -> R(out)
+    IQTensor M(conj(L),conj(S),R);
+    M += ITensor(lu,su,ru);
+    M += ITensor(ld,su,rd);
+    M += ITensor(lu,sd,rd);
+    M.randomize();
+
+    IQTensor E(L,primed(conj(L)));
+    E += ITensor(lu,primed(lu),1);
+    E += ITensor(ld,primed(ld),1);
+
+    IQTensor Md = conj(primed(M,Link));
+
+    IQTensor ref = E * M * Md;
+    IQTensor res = contract(E,M,Md);
+    CHECK((res-ref).norm() < 1E-10*ref.norm());
+    }
+
+BOOST_AUTO_TEST_SUITE_END()
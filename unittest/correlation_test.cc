@@ -0,0 +1,117 @@
+#include "test.h"
+#include "correlation.h"
+#include "model/spinhalf.h"
+#include "model/hubbard.h"
+#include "hams/heisenberg.h"
+#include "hams/HubbardChain.h"
+#include <boost/test/unit_test.hpp>
+
+struct CorrelationDefaults
+    {
+    static const int N = 8;
+    SpinHalf shmodel;
+    Hubbard hubmodel;
+
+    CorrelationDefaults() :
+    shmodel(N),
+    hubmodel(N)
+        { }
+
+    ~CorrelationDefaults() { }
+
+    };
+
+BOOST_FIXTURE_TEST_SUITE(CorrelationTest,CorrelationDefaults)
+
+TEST(SpinCorrelations)
+    {
+    IQMPO H = Heisenberg(shmodel);
+
+    InitState init(shmodel);
+    for(int j = 1; j <= N; ++j)
+        init.set(j,j%2==1 ? &SpinHalf::Up : &SpinHalf::Dn);
+
+    IQMPS psi(shmodel,init);
+    psi.cutoff(1E-12);
+    psi.maxm(100);
+    fitApplyMPO(psi,-0.4,psi,H,psi,Opt("Nsweep",3));
+
+    Vector sz;
+    localExpect(psi,&Model::sz,sz);
+
+    Matrix C;
+    correlationMatrix(psi,&Model::sz,&Model::sz,C);
+
+    Real nrm2 = psiphi(psi,psi);
+    Real totSz = 0;
+    for(int i = 1; i <= N; ++i)
+        {
+        totSz += sz(i);
+        CHECK_CLOSE(C(i,i),0.25,1E-10);
+
+        //Compare to moving the ortho center
+        psi.position(i);
+        IQTensor A = psi.A(i);
+        Real ref = Dot(primed(A,Site),A*shmodel.sz(i))/Dot(A,A);
+        CHECK(fabs(sz(i)-ref) < 1E-10);
+
+        for(int j = i+1; j <= N; ++j)
+            {
+            IQMPS Ophi(psi);
+            Ophi.Anc(i) = psi.A(i) * shmodel.sz(i);
+            Ophi.Anc(j) = psi.A(j) * shmodel.sz(j);
+            Ophi.Anc(i).noprime(Site);
+            Ophi.Anc(j).noprime(Site);
+            CHECK(fabs(C(i,j)-psiphi(psi,Ophi)/nrm2) < 1E-10);
+            CHECK(fabs(C(j,i)-C(i,j)) < 1E-10);
+            }
+        }
+    CHECK(fabs(totSz) < 1E-10);
+    }
+
+TEST(FermionCorrelations)
+    {
+    IQMPO H = HubbardChain(hubmodel,Opt("U",2));
+
+    InitState init(hubmodel);
+    for(int j = 1; j <= N; ++j)
+        init.set(j,j%2==1 ? &Hubbard::Up : &Hubbard::Dn);
+
+    //Apply (1-0.2*H)^3 to get correlations beyond
+    //nearest neighbors, which involve the string
+    IQMPS psi(hubmodel,init);
+    psi.cutoff(1E-12);
+    psi.maxm(100);
+    for(int n = 1; n <= 3; ++n)
+        {
+        fitApplyMPO(psi,-0.2,psi,H,psi,Opt("Nsweep",3));
+        }
+
+    Vector nup;
+    localExpect(psi,&Model::Nup,nup);
+
+    Matrix C;
+    correlationMatrix(psi,&Model::Cdagup,&Model::Cup,C,Opt("Fermionic",true));
+
+    Real totN = 0;
+    for(int i = 1; i <= N; ++i)
+        {
+        totN += nup(i);
+        CHECK(fabs(C(i,i)-nup(i)) < 1E-10);
+        //<Cdag_i C_j> is Hermitian; entries with i > j
+        //are computed using anticommutation so this
+        //checks the Jordan-Wigner signs
+        for(int j = i+1; j <= N; ++j)
+            {
+            CHECK(fabs(C(j,i)-C(i,j)) < 1E-10);
+            }
+        }
+    CHECK_CLOSE(totN,N/2,1E-10);
+
+    //Nearest-neighbor hopping must have the sign
+    //that lowers the kinetic energy -t*(Cdag_i C_j + h.c.)
+    CHECK(C(1,2) > 0);
+    CHECK(fabs(C(2,5)) > 1E-4);
+    }
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -2,12 +2,38 @@
 #include "eigensolver.h"
 #include "hams/heisenberg.h"
 #include "model/spinhalf.h"
-#include "localmpo.h"
+#include "dmrg.h"
 #include <boost/test/unit_test.hpp>
 
 using namespace std;
 using boost::format;
 
+//
+// LocalMPO which counts calls to product
+// done in single precision
+//
+template <class Tensor>
+class CountingLocalMPO : public LocalMPO<Tensor>
+    {
+    public:
+
+    CountingLocalMPO(const MPOt<Tensor>& H)
+        : LocalMPO<Tensor>(H), nfloat_(0) { }
+
+    void
+    product(const Tensor& phi, Tensor& phip) const
+        {
+        if(this->floatProduct()) ++nfloat_;
+        LocalMPO<Tensor>::product(phi,phip);
+        }
+
+    int
+    nfloat() const { return nfloat_; }
+
+    private:
+    mutable int nfloat_;
+    };
+
 struct EigenSolverDefaults
     {
     EigenSolverDefaults()
@@ -146,4 +172,114 @@ TEST(IQFourSite)
 
     }
 
+TEST(ConvergedGuess)
+    {
+    const int N = 4;
+    SpinHalf model(N);
+    IQMPO H = Heisenberg(model);
+
+    InitState initState(model);
+    for(int i = 1; i <= N; ++i)
+        initState.set(i,i%2==1 ? &SpinHalf::Up : &SpinHalf::Dn);
+
+    IQMPS psi(model,initState);
+
+    LocalMPO<IQTensor> PH(H);
+    psi.position(2);
+    PH.position(2,psi);
+
+    IQTensor phi = psi.A(2) * psi.A(3);
+
+    Eigensolver d(Opt("MaxIter",9) & Opt("ErrGoal",1E-6) & Opt("MinIter",0));
+    Real En1 = d.davidson(PH,phi);
+    CHECK(d.numProducts() > 1);
+
+    //Already converged starting vector:
+    //only one product needed
+    Real En2 = d.davidson(PH,phi);
+    CHECK_EQUAL(d.numProducts(),1);
+    CHECK(fabs(En1-En2) < 1E-10);
+
+    d.minIter(1);
+    d.davidson(PH,phi);
+    CHECK_EQUAL(d.numProducts(),2);
+    }
+
+TEST(ThickRestart)
+    {
+    const int N = 10;
+    SpinHalf model(N);
+    MPO H = Heisenberg(model);
+
+    InitState initState(model);
+    for(int i = 1; i <= N; ++i)
+        initState.set(i,i%2==1 ? &SpinHalf::Up : &SpinHalf::Dn);
+
+    //Get an MPS with a non-trivial local problem
+    MPS psi(model,initState);
+    Sweeps sweeps(2);
+    sweeps.maxm() = 8;
+    dmrg(psi,H,sweeps,Opt("Quiet",true));
+
+    const int b = N/2;
+    LocalMPO<ITensor> PH(H);
+    psi.position(b);
+    PH.position(b,psi);
+    ITensor phi0 = psi.A(b)*psi.A(b+1);
+    phi0.randomize();
+
+    ITensor phi1(phi0);
+    Eigensolver d1(Opt("MaxIter",60) & Opt("ErrGoal",1E-10));
+    const Real E1 = d1.davidson(PH,phi1);
+
+    ITensor phi2(phi0);
+    Eigensolver d2(Opt("MaxIter",120) & Opt("ErrGoal",1E-10) 
+                   & Opt("MaxSubspace",6) & Opt("NumRestart",2));
+    const Real E2 = d2.davidson(PH,phi2);
+    CHECK(d2.numProducts() > 6);
+
+    CHECK(fabs(E1-E2) < 1E-8);
+    CHECK(fabs(fabs(Dot(phi1,phi2))-1) < 1E-6);
+
+    //The residual of the result is small
+    ITensor Hphi;
+    PH.product(phi2,Hphi);
+    Hphi += (-E2)*phi2;
+    CHECK(Hphi.norm() < 1E-5);
+    }
+
+TEST(FloatProduct)
+    {
+    const int N = 10;
+    SpinHalf model(N);
+    IQMPO H = Heisenberg(model);
+
+    InitState initState(model);
+    for(int i = 1; i <= N; ++i)
+        initState.set(i,i%2==1 ? &SpinHalf::Up : &SpinHalf::Dn);
+
+    //The first three sweeps have cutoff >= FloatCutoff
+    Sweeps sweeps(6);
+    sweeps.maxm() = 10,20,40;
+    sweeps.cutoff() = 1E-3,1E-4,1E-5,1E-12;
+    sweeps.niter() = 5;
+
+    DMRGObserver obs;
+    obs.printEigs(false);
+    const OptSet opts = Opt("Quiet",true) & Opt("ErrGoal",1E-8)
+                      & Opt("FloatProduct",true);
+
+    IQMPS psi(model,initState);
+    CountingLocalMPO<IQTensor> PH(H);
+    const Real E = DMRGWorker(psi,PH,sweeps,obs,opts);
+
+    CHECK(PH.nfloat() > 0);
+    //Later sweeps switch back to double precision
+    CHECK(!PH.floatProduct());
+
+    //Exact ground state energy
+    const Real Eexact = -4.258035207282;
+    CHECK(fabs(E-Eexact) < 1E-8);
+    }
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,46 @@
+#include "test.h"
+#include "idmrg.h"
+#include "model/spinhalf.h"
+#include "hams/heisenberg.h"
+#include <boost/test/unit_test.hpp>
+
+struct iDMRGDefaults
+    {
+    iDMRGDefaults() { }
+
+    ~iDMRGDefaults() { }
+
+    };
+
+BOOST_FIXTURE_TEST_SUITE(iDMRGTest,iDMRGDefaults)
+
+TEST(HeisenbergChain)
+    {
+    //Two unit cells of two sites each
+    const int N = 4;
+    SpinHalf model(N);
+
+    Heisenberg heis(model,Opt("Infinite",true));
+    MPO H = heis;
+
+    InitState init(model);
+    for(int j = 1; j <= N; ++j)
+        init.set(j,j%2==1 ? &SpinHalf::Up : &SpinHalf::Dn);
+    MPS psi(model,init);
+
+    Sweeps sweeps(30);
+    sweeps.maxm() = 10,20,30,40,50;
+    sweeps.cutoff() = 1E-10;
+    sweeps.niter() = 3,2;
+
+    DMRGObserver obs;
+    obs.printEigs(false);
+    const Real E = idmrg(psi,H,heis.HL(),heis.HR(),sweeps,obs,Opt("Quiet",true));
+
+    //Exact energy per site of the infinite chain
+    const Real Eexact = 0.25-log(2.);
+    CHECK(fabs(E-Eexact) < 1E-4);
+    CHECK(psi.LinkInd(N/2).m() > 10);
+    }
+
+BOOST_AUTO_TEST_SUITE_END()
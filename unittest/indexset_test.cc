@@ -159,4 +159,44 @@ TEST(AddIndex)
     CHECK_EQUAL(P->r(),3);
     }
 
+TEST(FindAndCopy)
+    {
+    IQIndexSet is(S1,L3,primed(S2),L2);
+
+    CHECK_EQUAL(is.find(S1),0);
+    CHECK_EQUAL(is.find(primed(S2)),1);
+    CHECK_EQUAL(is.find(L3),3);
+    CHECK_EQUAL(is.find(S2),-1);
+    CHECK_EQUAL(is.find(L1),-1);
+    CHECK(hasindex(is,L2));
+    CHECK(!hasindex(is,primed(L2)));
+    CHECK_EQUAL(is.m(3),L2.m());
+    CHECK_EQUAL(is.dim(),S1.m()*S2.m()*L2.m());
+
+    //Copies and modified copies keep their
+    //lookup data consistent with their indices
+    IQIndexSet cp(is);
+    cp.prime(L2);
+    cp.noprime(primed(S2));
+    CHECK_EQUAL(cp.find(primed(L2)),2);
+    CHECK_EQUAL(cp.find(S2),1);
+    CHECK_EQUAL(is.find(L2),2);
+    CHECK(cp.same(1,is,1));
+    CHECK(!cp.same(3,is,3));
+
+    IQIndexSet as;
+    as = cp;
+    as.addindex(L1);
+    CHECK_EQUAL(as.r(),5);
+    CHECK_EQUAL(as.find(L1),3);
+    CHECK_EQUAL(as.find(L3),4);
+    CHECK_EQUAL(as.m(4),L1.m());
+
+    Permutation Q(2,1,4,3,5),
+                P;
+    getperm(as,IQIndexSet(as,Q),P);
+    for(int j = 1; j <= as.r(); ++j)
+        CHECK_EQUAL(P.dest(j),Q.dest(j));
+    }
+
 BOOST_AUTO_TEST_SUITE_END()
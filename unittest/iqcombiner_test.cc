@@ -209,4 +209,39 @@ TEST(CondenseProduct)
     CHECK(diff.norm() < 1E-12);
     }
 
+
+TEST(CondenseMatchesTensor)
+    {
+    //Several blocks of L1 and S2 have the same QN, so
+    //the condensed right Index has multi-block sectors
+    IQTensor psi(L1,S2,L2);
+    psi += ITensor(l1u,s2u,l2dd);
+    psi += ITensor(l1d,s2u,l20);
+    psi += ITensor(l1u,s2d,l20);
+    psi += ITensor(l1d,s2d,l2uu);
+    psi.randomize();
+
+    IQCombiner c(L1,S2);
+    c.doCondense(true);
+    c.init();
+    CHECK_EQUAL(c.right().m(),L1.m()*S2.m());
+    CHECK(c.right().nindex() < L1.nindex()*S2.nindex());
+
+    IQTensor cpsi = c * psi;
+    IQTensor ref = psi * IQTensor(c);
+    CHECK((cpsi-ref).norm() < 1E-12);
+    CHECK_CLOSE(cpsi.norm(),psi.norm(),1E-12);
+
+    IQTensor ucpsi = conj(c) * cpsi;
+    CHECK((ucpsi-psi).norm() < 1E-12);
+
+    //Priming the IQCombiner must update its block maps
+    IQCombiner pc(c);
+    pc.prime();
+    IQTensor ppsi = primed(psi);
+    IQTensor pcpsi = pc * ppsi;
+    CHECK(hasindex(pcpsi,pc.right()));
+    CHECK((conj(pc) * pcpsi - ppsi).norm() < 1E-12);
+    }
+
 BOOST_AUTO_TEST_SUITE_END()
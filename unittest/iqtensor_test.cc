@@ -388,4 +388,63 @@ TEST(BigNorm)
     CHECK_CLOSE(Z.normLogNum().logNum(),999.053,1E-4);
     }
 
+TEST(FloatProduct)
+    {
+    const IQTFloat Cf(C);
+    IQTensor R;
+    Cf.product(B,R);
+    IQTensor E = B*C;
+    CHECK(E.norm() > 0);
+    CHECK((R-E).norm() < 1E-5*E.norm());
+
+    //Result may be the same object as A
+    const IQTFloat Df(D);
+    IQTensor RD(B);
+    Df.product(RD,RD);
+    IQTensor ED = B*D;
+    CHECK(hasindex(RD,primed(L1,2)));
+    CHECK((RD-ED).norm() < 1E-5*ED.norm());
+
+    //Product of two IQTFloats
+    const IQTensor RB = (IQTFloat(B)*Cf).toTensor();
+    CHECK((RB-E).norm() < 1E-5*E.norm());
+    CHECK_EQUAL(RB.iten_size(),E.iten_size());
+    }
+
+TEST(TemporariesNotCopied)
+    {
+    //Copies are only counted when collecting
+    //product statistics (see prodstats.h)
+#ifdef COLLECT_PRODSTATS
+    int& copies = Prodstats::stats().iqt_copies;
+#else
+    int copies = 0;
+#endif
+
+    //Making phi+phi copies the blocks of phi once
+    int c0 = copies;
+    IQTensor S = phi + phi;
+    const int sumCopies = copies - c0;
+#ifdef COLLECT_PRODSTATS
+    CHECK(sumCopies > 0);
+#endif
+
+    //Further operations on the temporary
+    //should modify it in place
+    c0 = copies;
+    IQTensor R = (phi + phi) * 3. / 2. * LogNumber(2.);
+    CHECK_EQUAL(copies - c0,sumCopies);
+    CHECK_CLOSE(R.norm(),3*S.norm(),1E-10);
+
+    c0 = copies;
+    IQTensor T(phi);
+    T.swap(S);
+    S *= 2;
+#ifdef COLLECT_PRODSTATS
+    CHECK_EQUAL(copies - c0,1);
+#endif
+    CHECK_CLOSE(S.norm(),2*phi.norm(),1E-10);
+    CHECK_CLOSE(T.norm(),2*phi.norm(),1E-10);
+    }
+
 BOOST_AUTO_TEST_SUITE_END()
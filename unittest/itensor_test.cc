@@ -613,6 +613,96 @@ TEST(SumDifference)
 
 }
 
+TEST(PermutedSum)
+    {
+    //Sizes larger than the tile size of the 
+    //permuting kernel, with no dimension in common
+    //between the fastest dimensions of T1 and T2
+    Index i("i",21),j("j",35),k("k",3);
+    ITensor T1(i,j,k), T2(k,j,i), T3(j,i,k);
+    T1.randomize();
+    T2.randomize();
+    T3.randomize();
+
+    //Copy shares the data of T1, which must
+    //be left unchanged; 1E-3 factor makes the
+    //scale of r smaller than that of T2
+    ITensor r = 1E-3*T1;
+    r += 5*T2;
+    r -= T3;
+    //Elements may nearly cancel, so compare
+    //them to an absolute tolerance
+    for(int a = 1; a <= i.m(); ++a)
+    for(int b = 1; b <= j.m(); ++b)
+    for(int c = 1; c <= k.m(); ++c)
+        {
+        const Real x = 1E-3*T1(i(a),j(b),k(c))+5*T2(i(a),j(b),k(c))-T3(i(a),j(b),k(c));
+        CHECK(fabs(r(i(a),j(b),k(c))-x) < 1E-12);
+        }
+
+    std::vector<ITensor> T;
+    T.push_back(T1);
+    T.push_back(2*T2);
+    T.push_back(T3);
+    T.push_back(T1/3);
+    Vector cv(3);
+    cv(1) = 0.5; cv(2) = -1; cv(3) = 0.25;
+    ITensor lc;
+    linearComb(T,cv,lc);
+    CHECK(hasindex(lc,i) && hasindex(lc,j) && hasindex(lc,k));
+    ITensor diff = lc - (0.5*T1 - 2*T2 + 0.25*T3);
+    CHECK(diff.norm() < 1E-10);
+    }
+
+TEST(ProductScales)
+    {
+    //Long chain of products with large scale factors:
+    //renormalization of the data may be skipped for
+    //some of the products, but must not let it overflow
+    Index i("i",10);
+    ITensor M(i,primed(i));
+    M.randomize();
+    //Gives the data of M a known norm
+    M.scaleOutNorm();
+    const Real mn = M.norm();
+
+    ITensor P = 1E50*M, 
+            Q = M/mn;
+    for(int n = 1; n <= 20; ++n)
+        {
+        P *= primed(1E50*M); 
+        P.mapprime(2,1);
+        Q *= primed(M/mn); 
+        Q.mapprime(2,1);
+        }
+
+    //P is (1E50*mn)^21 Q
+    const Real lnP = P.normLogNum().logNum();
+    CHECK_CLOSE(lnP,Q.normLogNum().logNum()+21*log(1E50*mn),1E-8);
+
+    P *= LogNumber(-lnP,1);
+    Q /= Q.norm();
+    CHECK((P-Q).norm() < 1E-10);
+
+    //Products shrinking the data must not let it underflow
+    Index j("j",2);
+    ITensor v(j),
+            D(j,primed(j));
+    v(j(2)) = 1;
+    D(j(1),primed(j)(1)) = 1;
+    D(j(2),primed(j)(2)) = 1E-150;
+    v.scaleOutNorm();
+    D.scaleOutNorm();
+    for(int n = 1; n <= 3; ++n)
+        {
+        v *= D;
+        v.mapprime(1,0);
+        }
+    CHECK_CLOSE(v.normLogNum().logNum(),3*log(1E-150),1E-8);
+    v *= LogNumber(-v.normLogNum().logNum(),1);
+    CHECK_CLOSE(v(j(2)),1,1E-10);
+    }
+
 TEST(ContractingProduct)
     {
 
@@ -894,6 +984,118 @@ TEST(ComplexNonContractingProduct)
 
     }
 
+TEST(ComplexContractingProduct)
+    {
+    ITensor Lr(b2,b3,b4), Li(b2,b3,b4),
+            Rr(b3,a2,b5,b4), Ri(b3,a2,b5,b4);
+
+    Lr.randomize(); 
+    Li.randomize(); 
+    Rr.randomize();
+    Ri.randomize();
+
+    ITensor L = Complex_1()*Lr + Complex_i()*Li;
+    ITensor R = Complex_1()*Rr + Complex_i()*Ri;
+
+    ITensor res1 = L * R;
+
+    CHECK(hasindex(res1,b2));
+    CHECK(hasindex(res1,b5));
+    CHECK(hasindex(res1,Index::IndReIm()));
+    CHECK(!hasindex(res1,b3));
+    CHECK(!hasindex(res1,b4));
+
+    ITensor rdiff = realPart(res1)-(Lr*Rr-Li*Ri);
+    ITensor idiff = imagPart(res1)-(Lr*Ri+Li*Rr);
+
+    CHECK(rdiff.norm() < 1E-12);
+    CHECK(idiff.norm() < 1E-12);
+
+    //Complex scalar times complex tensor
+    ITensor z = 2*Complex_1() + 3*Complex_i();
+    ITensor zL = z * L;
+    CHECK((realPart(zL)-(2*Lr-3*Li)).norm() < 1E-12);
+    CHECK((imagPart(zL)-(3*Lr+2*Li)).norm() < 1E-12);
+    }
+
+TEST(FloatProduct)
+    {
+    ITensor T(b3,b4,l1,a1),
+            P(l1,b5,b3),
+            Q(b3,b2,l1);
+    T.randomize();
+    P.randomize();
+    Q.randomize();
+    T *= 1E10;
+
+    const ITFloat Tf(T);
+
+    ITensor R1;
+    Tf.product(P,R1);
+    CHECK(hasindex(R1,b5));
+    CHECK(hasindex(R1,b4));
+    CHECK(hasindex(R1,a1));
+    CHECK(!hasindex(R1,b3));
+    CHECK((R1-P*T).norm() < 1E-5*R1.norm());
+
+    //Contracted indices in the opposite order
+    //from P, so T's float data are rearranged
+    ITensor R2;
+    Tf.product(Q,R2);
+    CHECK((R2-Q*T).norm() < 1E-5*R2.norm());
+
+    //Result may be the same object as A
+    ITensor R3(P);
+    Tf.product(R3,R3);
+    CHECK((R3-R1).norm() < 1E-12*R1.norm());
+
+    //Complex A, real T
+    ITensor Pi(P.indices());
+    Pi.randomize();
+    ITensor Z = Complex_1()*P + Complex_i()*Pi;
+    ITensor RZ;
+    Tf.product(Z,RZ);
+    CHECK((RZ-Z*T).norm() < 1E-5*RZ.norm());
+
+    //Chains of products stay in single precision
+    ITensor V(a1,b2,b4);
+    V.randomize();
+    const ITFloat Pf(P),
+                  Vf(V);
+    const ITensor R4 = (Pf*Tf*Vf).toTensor();
+    const ITensor E4 = P*T*V;
+    CHECK((R4-E4).norm() < 1E-5*E4.norm());
+
+    //Adding data with indices in another order
+    ITensor U(a1,b5,b4);
+    U.randomize();
+    ITFloat S1 = Pf*Tf;
+    S1 += ITFloat(U);
+    const ITensor S2 = R1+U;
+    CHECK((S1.toTensor()-S2).norm() < 1E-5*S2.norm());
+
+    //Long chains of products, whose data would
+    //shrink into the denormal range of float
+    //if not kept normalized
+    Index c1("c1",50),
+          c2("c2",50);
+    ITensor M(c1,c2),
+            M2(c1,c2),
+            X(c1);
+    M.randomize();
+    M2.randomize();
+    M -= M2;
+    X.randomize();
+    const ITFloat Mf(M);
+    ITFloat Xf(X);
+    for(int n = 1; n <= 100; ++n)
+        {
+        X *= M;
+        Xf *= Mf;
+        }
+    CHECK((Xf.toTensor()-X).norm() < 1E-4*X.norm());
+    }
+
 TEST(TieIndices)
     {
 
@@ -1063,6 +1265,14 @@ TEST(ToFromMatrix11)
     CHECK_CLOSE(M(1,2),21,1E-10);
     CHECK_CLOSE(M(2,2),22,1E-10);
 
+    Matrix Mu;
+    A.toMatrix11(s2,s1,Mu,LogNumber(2*f));
+
+    CHECK_CLOSE(Mu(1,1),5.5,1E-10);
+    CHECK_CLOSE(Mu(2,1),6,1E-10);
+    CHECK_CLOSE(Mu(1,2),10.5,1E-10);
+    CHECK_CLOSE(Mu(2,2),11,1E-10);
+
     A *= -40;
     A.fromMatrix11(s2,s1,M);
 
@@ -1263,4 +1473,128 @@ TEST(NormTest)
     CHECK_CLOSE(C.norm(),sqrt(realPart(conj(C)*C).toReal()),1E-5);
     }
 
+TEST(TemporariesNotCopied)
+    {
+    //Copies are only counted when collecting
+    //product statistics (see prodstats.h)
+#ifdef COLLECT_PRODSTATS
+    int& copies = Prodstats::stats().it_copies;
+#else
+    int copies = 0;
+#endif
+
+    ITensor T1(b2,b3,b4);
+    T1.randomize();
+
+    //T1+T1 writes the sum to new storage
+    //instead of copying the data of T1 first
+    int c0 = copies;
+    ITensor S = T1 + T1;
+    CHECK_EQUAL(copies - c0,0);
+
+    //Further operations on the temporary
+    //should modify it in place
+    c0 = copies;
+    ITensor R = (T1 + T1) * 3. / 2. * LogNumber(2.);
+    CHECK_EQUAL(copies - c0,0);
+    CHECK_CLOSE(R.norm(),3*S.norm(),1E-10);
+
+    c0 = copies;
+    ITensor T(T1);
+    T.swap(S);
+    S *= 2;
+    //Writing to S copies the data it shares with T1
+    S(b2(1),b3(1),b4(1)) += 1;
+#ifdef COLLECT_PRODSTATS
+    CHECK_EQUAL(copies - c0,1);
+#endif
+    CHECK_CLOSE(T.norm(),2*T1.norm(),1E-10);
+    }
+
+TEST(Slab)
+    {
+    Index J("J",5),
+          j("j",2);
+    ITensor T(b3,J,b4);
+    T.randomize();
+    T *= 3;
+
+    //b3 runs contiguously in T and in S
+    ITensor S = T.slab(J,j,2);
+    CHECK(hasindex(S,j));
+    CHECK(!hasindex(S,J));
+    for(int i = 1; i <= b3.m(); ++i)
+    for(int k = 1; k <= j.m(); ++k)
+    for(int l = 1; l <= b4.m(); ++l)
+        {
+        CHECK_CLOSE(S(b3(i),j(k),b4(l)),T(b3(i),J(k+2),b4(l)),1E-10);
+        }
+
+    //First Index of U is strided in T
+    ITensor U(b4,j,b3);
+    U.randomize();
+    U *= 2;
+    ITensor T2(T);
+    T2.insertSlab(U,j,J,2);
+    for(int i = 1; i <= b3.m(); ++i)
+    for(int k = 1; k <= J.m(); ++k)
+    for(int l = 1; l <= b4.m(); ++l)
+        {
+        const bool in = (k > 2 && k <= 2+j.m());
+        CHECK_CLOSE(T2(b3(i),J(k),b4(l)),
+                    (in ? U(b3(i),j(k-2),b4(l)) : T(b3(i),J(k),b4(l))),1E-10);
+        }
+    CHECK((T2.slab(J,j,2)-U).norm() < 1E-10);
+    }
+
+TEST(HighRank)
+    {
+    //_ind follows the ordering of Counter
+    IndexSet<Index> is(b2,b3,l1,b4,b5);
+    Counter c(is);
+    for(; c.notDone(); ++c)
+        {
+        CHECK_EQUAL(_ind(is,c.i),c.ind);
+        }
+
+    //Rank 8 permutation and element access
+    ITensor T(l1,l2,l3,l4,l5,l6,l7,l8);
+    T.randomize();
+    ITensor P(l8,l7,l6,l5,l4,l3,l2,l1);
+    P = T;
+    CHECK_CLOSE(P(l1(2),l2(1),l3(2),l4(2),l5(1),l6(2),l7(1),l8(2)),
+                T(l1(2),l2(1),l3(2),l4(2),l5(1),l6(2),l7(1),l8(2)),1E-10);
+    CHECK_CLOSE(P(l8(2),l1(1),l2(1),l3(1),l4(1),l5(1),l6(1),l7(1)),
+                T(l1(1),l2(1),l3(1),l4(1),l5(1),l6(1),l7(1),l8(2)),1E-10);
+
+    if(NMAX < 10) return;
+
+    //Outer product of rank 10, contracted back
+    Index m1("m1",2),
+          m2("m2",3);
+    ITensor v1(m1),
+            v2(m2);
+    v1.randomize();
+    v2.randomize();
+    ITensor R = T*v1*v2;
+    CHECK_EQUAL(R.r(),10);
+    ITensor back = R*v1*v2;
+    back *= 1./(sqr(v1.norm())*sqr(v2.norm()));
+    CHECK((back-T).norm() < 1E-10);
+
+    //Same tensor with indices (m2,m1,l1,...,l8):
+    //the difference needs a rank 10 permutation
+    ITensor R2 = (v2*v1)*T;
+    CHECK((R2-R).norm() < 1E-10*R.norm());
+
+    //Small rank 9 product contracting a middle 
+    //index (done by directMultiply)
+    ITensor w(l4);
+    w.randomize();
+    ITensor T9 = T*v1;
+    CHECK_EQUAL(T9.r(),9);
+    ITensor res = T9*w;
+    CHECK((res-(T*w)*v1).norm() < 1E-10*res.norm());
+    }
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -267,4 +267,49 @@ TEST(Trace)
     }
 
 
+
+TEST(DiagScaling)
+    {
+    ITensor T(b3,b4,b5);
+    T.randomize();
+    T *= -2;
+
+    //Contract a diagonal matrix with each Index of T 
+    //(first, middle and last in storage)
+    const Index inds[] = { b3, b4, b5 };
+    for(int n = 0; n < 3; ++n)
+        {
+        const Index& I = inds[n];
+        const Index J = primed(I);
+        Vector d(I.m());
+        Matrix M(I.m(),I.m());
+        M = 0;
+        for(int j = 1; j <= I.m(); ++j) 
+            {
+            d(j) = 0.3*j-0.5;
+            M(j,j) = d(j);
+            }
+        ITSparse D(I,J,d);
+        D *= 3;
+        ITensor Dd(I,J,M);
+        Dd *= 3;
+
+        ITensor res = T * D;
+        CHECK(hasindex(res,J));
+        CHECK(!hasindex(res,I));
+        CHECK((res - T*Dd).norm() < 1E-12);
+
+        ITensor res2(T);
+        res2 *= D;
+        CHECK((res2 - res).norm() < 1E-12);
+        }
+
+    //All diagonal elements the same
+    ITSparse D2(b4,primed(b4),2.);
+    ITensor res = T * D2;
+    CHECK(hasindex(res,primed(b4)));
+    CHECK_CLOSE(res(b3(2),primed(b4)(3),b5(4)),2*T(b3(2),b4(3),b5(4)),1E-12);
+    CHECK_CLOSE(res.norm(),2*T.norm(),1E-12);
+    }
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -1,6 +1,8 @@
 #include "test.h"
 #include "localmpo.h"
 #include "model/spinhalf.h"
+#include "hams/heisenberg.h"
+#include "dmrg.h"
 #include <boost/test/unit_test.hpp>
 
 struct LocalMPODefaults
@@ -36,5 +38,51 @@ BOOST_AUTO_TEST_CASE(LocalMPOAsMPS)
     lmps.position(3,psiFerro);
     }
 
+BOOST_AUTO_TEST_CASE(FloatProduct)
+    {
+    IQMPO H = Heisenberg(shmodel);
+    IQMPS psi(shmodel,shNeel);
+    Sweeps sweeps(2);
+    sweeps.maxm() = 10;
+    dmrg(psi,H,sweeps,Opt("Quiet",true));
+
+    const int b = 4;
+    psi.position(b);
+    const IQTensor phi = psi.bondTensor(b);
+
+    LocalMPO<IQTensor> PH(H),
+                       PHf(H,Opt("FloatProduct",true));
+    PH.position(b,psi);
+    PHf.position(b,psi);
+
+    //Only the float copies of the 
+    //edge tensors are kept
+    CHECK(PHf.L().isNull());
+    CHECK(PHf.R().isNull());
+
+    IQTensor Hphi,
+             Hphif;
+    PH.product(phi,Hphi);
+    PHf.product(phi,Hphif);
+    CHECK(Hphi.norm() > 0);
+    CHECK((Hphif-Hphi).norm() < 1E-5*Hphi.norm());
+    CHECK((PHf.diag()-PH.diag()).norm() < 1E-5*PH.diag().norm());
+
+    //Moving to another bond makes the new
+    //edge tensors in single precision
+    psi.position(b+1);
+    PH.position(b+1,psi);
+    PHf.position(b+1,psi);
+    const IQTensor phi2 = psi.bondTensor(b+1);
+    PH.product(phi2,Hphi);
+    PHf.product(phi2,Hphif);
+    CHECK((Hphif-Hphi).norm() < 1E-5*Hphi.norm());
+
+    //Switching back converts the edge tensors
+    PHf.floatProduct(false);
+    CHECK(!PHf.L().isNull());
+    PHf.product(phi2,Hphif);
+    CHECK((Hphif-Hphi).norm() < 1E-5*Hphi.norm());
+    }
 
 BOOST_AUTO_TEST_SUITE_END()
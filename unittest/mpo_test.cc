@@ -31,4 +31,176 @@ BOOST_AUTO_TEST_CASE(Position)
     CHECK_EQUAL(H.orthoCenter(),1);
     }
 
+BOOST_AUTO_TEST_CASE(FitApplyMPO)
+    {
+    IQMPO H = Heisenberg(s1model);
+
+    InitState init(s1model);
+    for(int j = 1; j <= N; ++j)
+        init.set(j,j%2==1 ? &SpinOne::Up : &SpinOne::Dn);
+
+    //Entangled starting state
+    IQMPS psi(s1model,init);
+    exactApplyMPO(psi,H,psi);
+    psi.normalize();
+    psi.maxm(200);
+    psi.cutoff(1E-12);
+
+    IQMPS exact;
+    exactApplyMPO(psi,H,exact);
+
+    IQMPS fit;
+    Real err = fitApplyMPO(psi,H,fit,Opt("Nsweep",4));
+    CHECK(err < 1E-8);
+    CHECK(checkQNs(fit));
+
+    Real ee = psiphi(exact,exact),
+         ff = psiphi(fit,fit),
+         ef = psiphi(exact,fit);
+    CHECK_CLOSE(ef/sqrt(ee*ff),1,1E-8);
+    CHECK_CLOSE(ff/ee,1,1E-8);
+
+    //Fit psi - 0.1*H|psi> in place
+    IQMPS sum(exact);
+    sum *= -0.1;
+    sum += psi;
+
+    IQMPS res(psi);
+    fitApplyMPO(psi,-0.1,res,H,res,Opt("Nsweep",4));
+    Real ss = psiphi(sum,sum),
+         rr = psiphi(res,res),
+         sr = psiphi(sum,res);
+    CHECK_CLOSE(sr/sqrt(ss*rr),1,1E-8);
+    CHECK_CLOSE(rr/ss,1,1E-8);
+    }
+
+BOOST_AUTO_TEST_CASE(AddCompress)
+    {
+    IQMPO H = Heisenberg(s1model);
+
+    InitState init(s1model);
+    for(int j = 1; j <= N; ++j)
+        init.set(j,j%2==1 ? &SpinOne::Up : &SpinOne::Dn);
+    IQMPS psi(s1model,init);
+    exactApplyMPO(psi,H,psi);
+    psi.normalize();
+
+    const Real E = psiHphi(psi,H,psi);
+
+    //Repeated sums should not grow the bond dimension
+    IQMPO S(H);
+    for(int n = 2; n <= 4; ++n)
+        {
+        S += H;
+        CHECK(checkQNs(S));
+        for(int b = 1; b < N; ++b)
+            CHECK(S.LinkInd(b).m() <= H.LinkInd(b).m());
+        CHECK_CLOSE(psiHphi(psi,S,psi),n*E,1E-8);
+        }
+    }
+
+BOOST_AUTO_TEST_CASE(DirectSum)
+    {
+    IQMPO H = Heisenberg(s1model);
+
+    InitState init(s1model);
+    for(int j = 1; j <= N; ++j)
+        init.set(j,j%2==1 ? &SpinOne::Up : &SpinOne::Dn);
+    IQMPS psi(s1model,init);
+    exactApplyMPO(psi,H,psi);
+    psi.normalize();
+
+    std::vector<IQMPO> terms(4,H);
+    terms.at(1) *= 2;
+    IQMPO S;
+    directSum(terms,S,1E-13);
+    CHECK(checkQNs(S));
+    for(int b = 1; b < N; ++b)
+        CHECK(S.LinkInd(b).m() <= H.LinkInd(b).m());
+    CHECK_CLOSE(psiHphi(psi,S,psi),5*psiHphi(psi,H,psi),1E-8);
+    }
+
+BOOST_AUTO_TEST_CASE(MultMPO)
+    {
+    IQMPO H = Heisenberg(s1model);
+
+    InitState init(s1model);
+    for(int j = 1; j <= N; ++j)
+        init.set(j,j%2==1 ? &SpinOne::Up : &SpinOne::Dn);
+    IQMPS psi(s1model,init);
+    exactApplyMPO(psi,H,psi);
+    psi.normalize();
+
+    IQMPO H2;
+    nmultMPO(H,H,H2,Opt("Cutoff",1E-14));
+    CHECK(checkQNs(H2));
+
+    //Bond dimension of H^2 is far smaller than k^2
+    const int k = H.LinkInd(N/2).m();
+    CHECK(H2.LinkInd(N/2).m() < k*k);
+
+    CHECK_CLOSE(psiHphi(psi,H2,psi),psiHKphi(psi,H,H,psi),1E-8);
+
+    //Truncated product (the IQ SVD may keep
+    //a few more states to avoid splitting
+    //degenerate singular values)
+    IQMPO H2t;
+    nmultMPO(H,H,H2t,Opt("Cutoff",1E-14) & Opt("Maxm",8));
+    CHECK(H2t.LinkInd(N/2).m() <= 8);
+    for(int b = 1; b < N; ++b)
+        CHECK(H2t.LinkInd(b).m() <= H2.LinkInd(b).m());
+    }
+
+
+BOOST_AUTO_TEST_CASE(MPOTensorBuilderTest)
+    {
+    const int n = 3;
+    const Real J = 0.7;
+
+    //ITensor version
+    Index row("row",4), col("col",4);
+    MPOTensorBuilder<ITensor> B(row,col);
+    B.add(1,1,s1model.id(n));
+    B.add(4,4,s1model.id(n));
+    B.add(2,1,s1model.sz(n));
+    B.add(4,2,s1model.sz(n),J);
+    B.add(4,2,s1model.sp(n),-J);
+    B.add(3,1,s1model.sm(n),0);
+    CHECK_EQUAL(B.numEntries(),5);
+
+    ITensor W;
+    B.build(W);
+
+    ITensor Wref(s1model.si(n),s1model.siP(n),row,col);
+    Wref += s1model.id(n) * row(1) * col(1);
+    Wref += s1model.id(n) * row(4) * col(4);
+    Wref += s1model.sz(n) * row(2) * col(1);
+    Wref += s1model.sz(n) * row(4) * col(2) * J;
+    Wref += s1model.sp(n) * row(4) * col(2) * (-J);
+    CHECK_EQUAL(W.r(),4);
+    CHECK((W-Wref).norm() < 1E-12);
+
+    //IQTensor version: S+ (S-) changes the QN by +2 (-2)
+    Index r0("r0",2), rP("rP",1), c0("c0",2), cM("cM",1);
+    IQIndex irow("irow",r0,QN(0),rP,QN(2),Out),
+            icol("icol",c0,QN(0),cM,QN(-2),Out);
+    irow.conj();
+
+    MPOTensorBuilder<IQTensor> IB(irow,icol);
+    IB.add(1,1,s1model.id(n));
+    IB.add(2,2,s1model.sz(n),J);
+    IB.add(1,3,s1model.sp(n),J/2);
+    IB.add(3,1,s1model.sp(n));
+    IQTensor IW;
+    IB.build(IW);
+    CHECK_EQUAL(div(IW),QN());
+
+    IQTensor IWref(conj(s1model.si(n)),s1model.siP(n),irow,icol);
+    IWref += s1model.id(n) * irow(1) * icol(1);
+    IWref += s1model.sz(n) * irow(2) * icol(2) * J;
+    IWref += s1model.sp(n) * irow(1) * icol(3) * (J/2);
+    IWref += s1model.sp(n) * irow(3) * icol(1);
+    CHECK((IW-IWref).norm() < 1E-12);
+    }
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -87,5 +87,96 @@ TEST(PositionTest)
     CHECK_EQUAL(findCenter(psi),4);
     }
 
+TEST(SumTerms)
+    {
+    //Product states with the same total Sz, 
+    //each obtained by swapping a pair of 
+    //neighboring spins of the Neel state
+    std::vector<IQMPS> terms;
+    for(int j = 1; j < N; j += 2)
+        {
+        InitState init(shNeel);
+        init.set(j,&SpinHalf::Dn);
+        init.set(j+1,&SpinHalf::Up);
+        terms.push_back(IQMPS(shmodel,init));
+        }
+    terms.push_back(IQMPS(shmodel,shNeel));
+    const int Nt = terms.size();
+
+    IQMPS tree, direct;
+    sum(terms,tree);
+    directSum(terms,direct);
+    CHECK(checkQNs(direct));
+
+    CHECK_CLOSE(psiphi(tree,tree),Nt,1E-10);
+    CHECK_CLOSE(psiphi(direct,direct),Nt,1E-10);
+    CHECK_CLOSE(psiphi(tree,direct),Nt,1E-10);
+    for(int t = 0; t < Nt; ++t)
+        {
+        CHECK_CLOSE(psiphi(terms[t],direct),1,1E-10);
+        }
+
+    //Repeated terms compress to a multiple of one term
+    std::vector<MPS> iterms(3,MPS(shmodel,shNeel));
+    MPS idirect;
+    directSum(iterms,idirect);
+    CHECK_CLOSE(psiphi(idirect,idirect),9,1E-10);
+    CHECK_EQUAL(idirect.LinkInd(N/2).m(),1);
+    }
+
+TEST(SiteOpCache)
+    {
+    IQTensor sz = shmodel.sz(2);
+    CHECK_CLOSE(sz(conj(shmodel.si(2))(1),shmodel.siP(2)(1)),0.5,1E-10);
+    CHECK_CLOSE(sz(conj(shmodel.si(2))(2),shmodel.siP(2)(2)),-0.5,1E-10);
+
+    //Modifying a copy must not modify the cached operator
+    sz *= 2;
+    sz.prime();
+    IQTensor sz2 = shmodel.sz(2);
+    CHECK_EQUAL(sz2.r(),2);
+    CHECK(hasindex(sz2,shmodel.siP(2)));
+    CHECK_CLOSE(sz2(conj(shmodel.si(2))(1),shmodel.siP(2)(1)),0.5,1E-10);
+
+    ITensor diff = shmodel.opIT(Model::SzOp,2) - sz2.toITensor();
+    CHECK(diff.norm() < 1E-12);
+
+    CHECK(&shmodel.op(Model::SpOp,3) == &shmodel.op(Model::SpOp,3));
+    CHECK(&shmodel.op(Model::SpOp,3) != &shmodel.op(Model::SpOp,4));
+    }
+
+TEST(ConvertToIQ)
+    {
+    //Superposition of product states with total Sz = 0,
+    //giving link indices with several QN sectors
+    std::vector<IQMPS> terms;
+    for(int j = 1; j < N; ++j)
+        {
+        InitState init(shNeel);
+        init.set(j,j%2==1 ? &SpinHalf::Dn : &SpinHalf::Up);
+        init.set(j+1,j%2==1 ? &SpinHalf::Up : &SpinHalf::Dn);
+        IQMPS t(shmodel,init);
+        t *= 1.0/j;
+        terms.push_back(t);
+        }
+    IQMPS iqpsi;
+    directSum(terms,iqpsi);
+
+    MPS psi(shmodel);
+    for(int j = 1; j <= N; ++j)
+        psi.Anc(j) = iqpsi.A(j).toITensor();
+
+    IQMPS conv;
+    psi.toIQ(QN(),conv);
+    CHECK(checkQNs(conv));
+    CHECK_EQUAL(totalQN(conv),QN());
+    const Real nrm2 = psiphi(iqpsi,iqpsi);
+    CHECK_CLOSE(psiphi(conv,conv),nrm2,1E-10);
+    CHECK_CLOSE(psiphi(iqpsi,conv),nrm2,1E-10);
+    for(int b = 1; b < N; ++b)
+        {
+        CHECK(conv.LinkInd(b).m() <= psi.LinkInd(b).m());
+        }
+    }
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,127 @@
+#include "test.h"
+#include "mpsoverlap.h"
+#include "model/spinhalf.h"
+#include "hams/heisenberg.h"
+#include <boost/test/unit_test.hpp>
+
+struct MPSOverlapDefaults
+    {
+    static const int N = 10;
+    SpinHalf shmodel;
+    IQMPO H;
+    IQMPS psi, 
+          phi;
+
+    MPSOverlapDefaults() :
+    shmodel(N)
+        {
+        H = Heisenberg(shmodel);
+
+        InitState neel(shmodel);
+        for(int j = 1; j <= N; ++j)
+            {
+            neel.set(j,j%2==1 ? &SpinHalf::Up : &SpinHalf::Dn);
+            }
+
+        //Make two different entangled states
+        psi = IQMPS(shmodel,neel);
+        psi.cutoff(1E-12);
+        psi.maxm(100);
+        phi = psi;
+        fitApplyMPO(psi,-0.3,psi,H,psi,Opt("Nsweep",3));
+        fitApplyMPO(phi,-0.6,phi,H,phi,Opt("Nsweep",3));
+        psi.normalize();
+        phi.normalize();
+        }
+
+    ~MPSOverlapDefaults() { }
+
+    };
+
+//
+// Reference <psi|A_i B_j|phi> computed by applying 
+// the operators to a copy of phi
+//
+Real
+refCorrelation(const IQMPS& psi, const IQMPS& phi,
+               int i, const IQTensor& A, 
+               int j, const IQTensor& B)
+    {
+    IQMPS Ophi(phi);
+    Ophi.Anc(j) = phi.A(j) * B;
+    Ophi.Anc(j).noprime(Site);
+    Ophi.Anc(i) = Ophi.A(i) * A;
+    Ophi.Anc(i).noprime(Site);
+    return psiphi(psi,Ophi);
+    }
+
+BOOST_FIXTURE_TEST_SUITE(MPSOverlapTest,MPSOverlapDefaults)
+
+TEST(Value)
+    {
+    MPSOverlap<IQTensor> O(psi,phi);
+    CHECK_CLOSE(O.value(),psiphi(psi,phi),1E-10);
+
+    //Cached environments give the same answer
+    //from either direction
+    O.L(N);
+    CHECK_CLOSE(O.value(),psiphi(psi,phi),1E-10);
+
+    MPSOverlap<IQTensor> OH(psi,H,phi);
+    CHECK_CLOSE(OH.value(),psiHphi(psi,H,phi),1E-10);
+
+    MPS ipsi(shmodel), 
+        iphi(shmodel);
+    for(int j = 1; j <= N; ++j)
+        {
+        ipsi.Anc(j) = psi.A(j).toITensor();
+        iphi.Anc(j) = phi.A(j).toITensor();
+        }
+    MPSOverlap<ITensor> Oi(ipsi,iphi);
+    CHECK_CLOSE(Oi.value(),psiphi(psi,phi),1E-10);
+    }
+
+TEST(Expect)
+    {
+    MPSOverlap<IQTensor> O(psi,phi);
+    for(int i = 1; i <= N; ++i)
+        {
+        IQMPS Ophi(phi);
+        Ophi.Anc(i) = phi.A(i) * shmodel.sz(i);
+        Ophi.Anc(i).noprime(Site);
+        CHECK_CLOSE(O.expect(i,shmodel.sz(i)),psiphi(psi,Ophi),1E-10);
+        }
+    }
+
+TEST(Correlations)
+    {
+    std::vector<IQTensor> A(N+1),
+                          B(N+1);
+    for(int j = 1; j <= N; ++j)
+        {
+        A.at(j) = shmodel.sp(j);
+        B.at(j) = shmodel.sm(j);
+        }
+    //Leave out one operator to check
+    //that null entries are skipped
+    B.at(4) = IQTensor();
+
+    MPSOverlap<IQTensor> O(psi,phi);
+    Matrix C;
+    O.correlations(A,B,C);
+
+    for(int i = 1; i <= N; ++i)
+    for(int j = 1; j <= N; ++j)
+        {
+        if(j == 4)
+            {
+            CHECK_EQUAL(C(i,j),0);
+            continue;
+            }
+        Real ref = (i == j ? refCorrelation(psi,phi,i,multSiteOps(A.at(i),B.at(i)),i,shmodel.id(i))
+                           : refCorrelation(psi,phi,i,A.at(i),j,B.at(j)));
+        CHECK_CLOSE(C(i,j),ref,1E-10);
+        }
+    }
+
+BOOST_AUTO_TEST_SUITE_END()
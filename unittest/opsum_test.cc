@@ -0,0 +1,222 @@
+#include "test.h"
+#include "opsum.h"
+#include "model/spinhalf.h"
+#include "model/hubbard.h"
+#include "hams/heisenberg.h"
+#include "hams/HubbardChain.h"
+#include <boost/test/unit_test.hpp>
+
+struct OpSumDefaults
+    {
+    static const int N = 8;
+    SpinHalf shmodel;
+    Hubbard hubmodel;
+
+    OpSumDefaults() :
+    shmodel(N),
+    hubmodel(N)
+        { }
+
+    ~OpSumDefaults() { }
+
+    };
+
+//
+// Returns an entangled state by applying
+// (1 - 0.3 H) twice to a Neel state
+//
+template <class ModelT>
+IQMPS
+entangledState(const ModelT& model, const IQMPO& H,
+               IQIndexVal (ModelT::*up)(int) const,
+               IQIndexVal (ModelT::*dn)(int) const)
+    {
+    InitState init(model);
+    for(int j = 1; j <= model.N(); ++j)
+        init.set(j,j%2==1 ? up : dn);
+    IQMPS psi(model,init);
+    psi.cutoff(1E-12);
+    psi.maxm(100);
+    fitApplyMPO(psi,-0.3,psi,H,psi,Opt("Nsweep",3));
+    fitApplyMPO(psi,-0.3,psi,H,psi,Opt("Nsweep",3));
+    return psi;
+    }
+
+int
+maxLinkM(const IQMPO& H)
+    {
+    int m = 0;
+    for(int b = 1; b < H.N(); ++b)
+        m = max(m,H.LinkInd(b).m());
+    return m;
+    }
+
+BOOST_FIXTURE_TEST_SUITE(OpSumTest,OpSumDefaults)
+
+TEST(HeisenbergChain)
+    {
+    OpSum ops(shmodel);
+    for(int j = 1; j < N; ++j)
+        {
+        ops.add(1.0,&Model::sz,j,&Model::sz,j+1);
+        ops.add(0.5,&Model::sp,j,&Model::sm,j+1);
+        ops.add(0.5,&Model::sm,j,&Model::sp,j+1);
+        }
+
+    IQMPO H;
+    ops.toMPO(H);
+    CHECK_EQUAL(maxLinkM(H),5);
+
+    IQMPO Href = Heisenberg(shmodel);
+    IQMPS psi = entangledState(shmodel,Href,&SpinHalf::Up,&SpinHalf::Dn);
+
+    Real E = psiHphi(psi,H,psi),
+         Eref = psiHphi(psi,Href,psi);
+    CHECK_CLOSE(E,Eref,1E-10);
+
+    IQMPO Hc;
+    ops.toMPO(Hc,Opt("Compress",true));
+    CHECK(checkQNs(Hc));
+    CHECK(maxLinkM(Hc) <= 5);
+    CHECK_CLOSE(psiHphi(psi,Hc,psi),Eref,1E-10);
+
+    //ITensor version
+    MPO Hi;
+    ops.toMPO(Hi);
+    InitState init(shmodel);
+    for(int j = 1; j <= N; ++j)
+        init.set(j,j%2==1 ? &SpinHalf::Up : &SpinHalf::Dn);
+    MPS neel(shmodel,init);
+    init.set(1,&SpinHalf::Dn);
+    init.set(2,&SpinHalf::Up);
+    MPS flip(shmodel,init);
+    CHECK_CLOSE(psiHphi(neel,Hi,neel),-0.25*(N-1),1E-10);
+    CHECK_CLOSE(psiHphi(flip,Hi,neel),0.5,1E-10);
+    }
+
+TEST(SmallTermsKept)
+    {
+    //By default toMPO does no truncation, which
+    //would drop this small long-range term
+    const Real h = 1E-7;
+    OpSum ops(shmodel);
+    for(int j = 1; j < N; ++j)
+        {
+        ops.add(1.0,&Model::sz,j,&Model::sz,j+1);
+        ops.add(0.5,&Model::sp,j,&Model::sm,j+1);
+        ops.add(0.5,&Model::sm,j,&Model::sp,j+1);
+        }
+    ops.add(h,&Model::sz,1,&Model::sz,N);
+
+    IQMPO H;
+    ops.toMPO(H);
+    CHECK(checkQNs(H));
+
+    InitState init(shmodel);
+    for(int j = 1; j <= N; ++j)
+        init.set(j,j%2==1 ? &SpinHalf::Up : &SpinHalf::Dn);
+    IQMPS neel(shmodel,init);
+    CHECK_CLOSE(psiHphi(neel,H,neel),-0.25*(N-1)-0.25*h,1E-10);
+    }
+
+TEST(HeisenbergLadder)
+    {
+    const int Ny = 2;
+    OpSum ops(shmodel);
+    for(int j = 1; j <= N; ++j)
+        {
+        const int y = (j-1)%Ny+1;
+        if(y != Ny)
+            {
+            ops.add(1.0,&Model::sz,j,&Model::sz,j+1);
+            ops.add(0.5,&Model::sp,j,&Model::sm,j+1);
+            ops.add(0.5,&Model::sm,j,&Model::sp,j+1);
+            }
+        if(j+Ny <= N)
+            {
+            ops.add(1.0,&Model::sz,j,&Model::sz,j+Ny);
+            ops.add(0.5,&Model::sp,j,&Model::sm,j+Ny);
+            ops.add(0.5,&Model::sm,j,&Model::sp,j+Ny);
+            }
+        }
+
+    IQMPO H;
+    ops.toMPO(H);
+    CHECK(checkQNs(H));
+
+    IQMPO Href = Heisenberg(shmodel,Opt("Ny",Ny));
+    CHECK(maxLinkM(H) <= Href.LinkInd(N/2).m());
+
+    IQMPS psi = entangledState(shmodel,Href,&SpinHalf::Up,&SpinHalf::Dn);
+    CHECK_CLOSE(psiHphi(psi,H,psi),psiHphi(psi,Href,psi),1E-10);
+    }
+
+TEST(LongRange)
+    {
+    //Exponentially decaying interactions have an
+    //MPO with a bond dimension independent of range
+    const Real lambda = 0.5;
+    OpSum ops(shmodel);
+    for(int i = 1; i <= N; ++i)
+        {
+        ops.add(0.1*i,&Model::sz,i);
+        for(int j = i+1; j <= N; ++j)
+            ops.add(pow(lambda,j-i),&Model::sz,i,&Model::sz,j);
+        }
+
+    IQMPO H,Hc;
+    ops.toMPO(H);
+    ops.toMPO(Hc,Opt("Compress",true));
+    CHECK(checkQNs(Hc));
+    CHECK_EQUAL(H.LinkInd(N/2).m(),N/2+2);
+    CHECK_EQUAL(maxLinkM(Hc),3);
+
+    IQMPO Href = Heisenberg(shmodel);
+    IQMPS psi = entangledState(shmodel,Href,&SpinHalf::Up,&SpinHalf::Dn);
+
+    //Direct computation of the expectation value
+    Real ref = 0;
+    for(int i = 1; i <= N; ++i)
+        {
+        IQMPS phi(psi);
+        phi.Anc(i) = phi.A(i)*shmodel.sz(i);
+        phi.Anc(i).noprime();
+        ref += 0.1*i*psiphi(psi,phi);
+        for(int j = i+1; j <= N; ++j)
+            {
+            IQMPS phi2(phi);
+            phi2.Anc(j) = phi2.A(j)*shmodel.sz(j);
+            phi2.Anc(j).noprime();
+            ref += pow(lambda,j-i)*psiphi(psi,phi2);
+            }
+        }
+
+    CHECK_CLOSE(psiHphi(psi,H,psi),ref,1E-10);
+    CHECK_CLOSE(psiHphi(psi,Hc,psi),ref,1E-10);
+    }
+
+TEST(HubbardHopping)
+    {
+    const Real U = 2;
+    OpSum ops(hubmodel);
+    for(int j = 1; j <= N; ++j)
+        {
+        ops.add(U,&Model::Nupdn,j);
+        if(j == N) continue;
+        ops.addFermionic(-1,&Model::Cdagup,j,&Model::Cup,j+1);
+        ops.addFermionic(-1,&Model::Cdagup,j+1,&Model::Cup,j);
+        ops.addFermionic(-1,&Model::Cdagdn,j,&Model::Cdn,j+1);
+        ops.addFermionic(-1,&Model::Cdagdn,j+1,&Model::Cdn,j);
+        }
+
+    IQMPO H;
+    ops.toMPO(H);
+    CHECK(checkQNs(H));
+    CHECK(maxLinkM(H) <= 6);
+
+    IQMPO Href = HubbardChain(hubmodel,Opt("U",U));
+    IQMPS psi = entangledState(hubmodel,Href,&Hubbard::Up,&Hubbard::Dn);
+    CHECK_CLOSE(psiHphi(psi,H,psi),psiHphi(psi,Href,psi),1E-10);
+    }
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -222,4 +222,29 @@ TEST(IndexOrder)
     }
     */
 
+TEST(DenmatAbsoluteCutoff)
+    {
+    //The data of rho in denmatDecomp need not be 
+    //normalized, but an absolute cutoff with DoRelCutoff
+    //must be applied to the eigenvalues of rho/|rho|
+    Index a("a",4),b("b",4),mid("mid",4);
+
+    //AA has a scale of 1E-10 and data of norm about 1E10
+    ITensor X(a,b);
+    for(int k = 1; k <= 4; ++k)
+        {
+        X(a(k),b(k)) = 1E10*pow(0.1,k-1);
+        }
+    ITensor AA = 1E-10*X;
+
+    SVDWorker svd(Opt("AbsoluteCutoff",true) & Opt("DoRelCutoff",true) 
+                  & Opt("Cutoff",1E-3));
+    ITensor A(a,mid),B(mid,b);
+    svd.denmatDecomp(AA,A,B,Fromleft);
+
+    //Eigenvalues of rho are 1, 1E-2, 1E-4 and 1E-6
+    CHECK_EQUAL(svd.numEigsKept(),2);
+    CHECK((A*B-AA).norm() < 1E-2*AA.norm());
+    }
+
 BOOST_AUTO_TEST_SUITE_END()